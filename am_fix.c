@@ -19,8 +19,6 @@
 //
 // that is until someone works out how to properly configure the BK chip !
 
-#include <string.h>
-
 #include "am_fix.h"
 #include "app/main.h"
 #include "board.h"
@@ -29,6 +27,7 @@
 #include "frequencies.h"
 #include "functions.h"
 #include "misc.h"
+#include "radio.h"
 #include "settings.h"
 #ifdef ENABLE_AGC_SHOW_DATA
 #include "ui/main.h"
@@ -93,6 +92,12 @@ typedef struct
 
 // lookup table is hugely easier than writing code to do the same
 //
+// LOOKUP_TABLE 1 (the default) is the hand picked table below, it gets down
+// to a gain by backing off the PGA/mixer first and keeps the LNAs up.
+// LOOKUP_TABLE 0 uses the full table from am_fix_table.h, one entry per dB
+// value but with the first register combination found for it, which is the
+// one with the LNAs furthest down, so it stays off until it's been tried at
+// the radio ('make am_fix_table_test' checks it against the old CreateTable())
 
 #define LOOKUP_TABLE 1
 
@@ -145,68 +150,14 @@ static const t_gain_table gain_table[] =
 	{0x03FF,0}      // 42 .. 3 7 3 7 ..   0dB   0dB  0dB   0dB ..   0dB
 };
 
-const uint8_t gain_table_size = ARRAY_SIZE(gain_table);
 #else
-
-t_gain_table gain_table[100] = {{0x03BE, -7}}; //original
-uint8_t gain_table_size = 0;
-
-void CreateTable()
-{
-typedef union  {
-    struct {
-        uint8_t pgaIdx:3;
-        uint8_t mixerIdx:2;
-        uint8_t lnaIdx:3;
-        uint8_t lnaSIdx:2;
-    };
-    uint16_t __raw;
-} GainData;
-
-	static const int8_t lna_short_dB[] = {-28, -24, -19,  0};   // corrected'ish
-	static const int8_t lna_dB[]       = {-24, -19, -14,  -9, -6, -4, -2, 0};
-	static const int8_t mixer_dB[]     = { -8,  -6,  -3,   0};
-	static const int8_t pga_dB[]       = {-33, -27, -21, -15, -9, -6, -3, 0};
-
-	unsigned i;
-    for (uint8_t lnaSIdx = 0; lnaSIdx < ARRAY_SIZE(lna_short_dB); lnaSIdx++) {
-        for (uint8_t lnaIdx = 0; lnaIdx < ARRAY_SIZE(lna_dB); lnaIdx++) {
-            for (uint8_t mixerIdx = 0; mixerIdx < ARRAY_SIZE(mixer_dB); mixerIdx++) {
-                for (uint8_t pgaIdx = 0; pgaIdx < ARRAY_SIZE(pga_dB); pgaIdx++) {
-                    int16_t db = lna_short_dB[lnaSIdx] + lna_dB[lnaIdx] + mixer_dB[mixerIdx] + pga_dB[pgaIdx];
-                    GainData gainData = {{
-                        pgaIdx,
-                        mixerIdx,
-                        lnaIdx,
-                        lnaSIdx,
-                    }};
-
-                    for (i = 1; i < ARRAY_SIZE(gain_table); i++) {
-                        t_gain_table * gain = &gain_table[i];
-                        if (db == gain->gain_dB)
-                            break;
-                        if (db > gain->gain_dB)
-                            continue;
-                        if (db < gain->gain_dB) {
-                            if(gain->gain_dB)
-                                memmove(gain + 1, gain, 100 - i);
-                            gain->gain_dB = db;
-                            gain->reg_val = gainData.__raw;
-                            break;
-                        }
-                        gain->gain_dB = db;
-                        gain->reg_val = gainData.__raw;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    gain_table_size = i+1;
-}
+// sorted/de-duplicated table of every REG_13 gain combination, generated on
+// the host by utils/am_fix_table.py ('make am_fix_table') and kept in flash
+#include "am_fix_table.h"
 #endif
 
+static const uint8_t gain_table_size = ARRAY_SIZE(gain_table);
+
 
 #ifdef ENABLE_AM_FIX_SHOW_DATA
 	// display update rate
@@ -214,27 +165,97 @@ typedef union  {
 	unsigned int counter = 0;
 #endif
 
+// AGC time constants, in 10ms ticks as a power of 2 (IIR filter shift)
+//
+// attack follows a rising signal quickly so we back the gain off before
+// the AM demodulator saturates, decay is kept slow so the gain doesn't
+// pump up on every fade/dip of the carrier
+//
+// all of these can be overridden from the compiler command line, which is
+// how utils/am_fix_sim.c tunes them against recorded RSSI traces
+#ifndef AM_FIX_ATTACK_SHIFT
+	#define AM_FIX_ATTACK_SHIFT   1      // ~20ms
+#endif
+#ifndef AM_FIX_DECAY_SHIFT
+	#define AM_FIX_DECAY_SHIFT    6      // ~640ms
+#endif
+// fixed point fraction bits of the filtered RSSI level
+#define AM_FIX_LEVEL_FRAC     4
+// ticks to hold the gain after a reduction before we may increase it again
+#ifndef AM_FIX_HOLD_10ms
+	#define AM_FIX_HOLD_10ms      30     // 300ms
+#endif
+// ticks to ignore the RSSI after a gain change, the BK4819 needs a moment
+// before the RSSI register reflects the new front end setting
+#ifndef AM_FIX_SETTLE_10ms
+	#define AM_FIX_SETTLE_10ms    1
+#endif
+// only increase gain if the next table entry is at least this far below
+// the wanted gain (helps reduce gain hunting)
+#ifndef AM_FIX_HYSTERESIS_dB
+	#define AM_FIX_HYSTERESIS_dB  6
+#endif
+// -89dBm, any higher and the AM demodulator starts to saturate/clip/distort
+#ifndef AM_FIX_DESIRED_RSSI_dBm
+	#define AM_FIX_DESIRED_RSSI_dBm  (-89)
+#endif
+
+// wanted RSSI per modulation in dBm, 0 = we don't look after this modulation
+//
+// FM copes with a far stronger signal than AM/SSB, there we're mostly after
+// keeping strong signals from overloading the front end
+static const int8_t desired_rssi_mod_dBm[MODULATION_UKNOWN] =
+{
+	[MODULATION_AM]  = AM_FIX_DESIRED_RSSI_dBm,
+#ifdef ENABLE_SOFT_AGC
+	[MODULATION_FM]  = -65,
+	[MODULATION_USB] = -85,
+	#ifdef ENABLE_BYP_RAW_DEMODULATORS
+		[MODULATION_BYP] = -85,
+		[MODULATION_RAW] = -85,
+	#endif
+#endif
+};
+
+// wanted RSSI correction per band in dB, relative to the modulation target
+static const int8_t desired_rssi_band_dB[BAND_N_ELEM] =
+{
+	0,   // BAND1_50MHz
+	0,   // BAND2_108MHz (airband)
+	0,   // BAND3_137MHz
+	0,   // BAND4_174MHz
+	0,   // BAND5_350MHz
+	0,   // BAND6_400MHz
+	0,   // BAND7_470MHz
+};
+
 unsigned int gain_table_index[2] = {0, 0};
-// used simply to detect a changed gain setting
+// index last written to REG_13, used to skip writing an unchanged gain setting
 unsigned int gain_table_index_prev[2] = {0, 0};
-// holds the previous RSSI level .. we do an average of old + new RSSI reading
+// last raw RSSI reading
 int16_t prev_rssi[2] = {0, 0};
-// to help reduce gain hunting, peak hold count down tick
+// filtered RX level referred to the front end input (RSSI minus current gain),
+// in 0.5dB units with AM_FIX_LEVEL_FRAC fraction bits, 0 = no reading yet
+static int32_t level[2] = {0, 0};
+// to help reduce gain hunting, gain hold count down tick
 unsigned int hold_counter[2] = {0, 0};
-// -89dBm, any higher and the AM demodulator starts to saturate/clip/distort
-const int16_t desired_rssi = (-89 + 160) * 2;
+// RSSI settle count down tick after a gain change
+static unsigned int settle_counter[2] = {0, 0};
+// wanted RSSI for the current band/modulation in 0.5dB units (same units as BK4819_GetRSSI())
+static int16_t desired_rssi[2] = {(AM_FIX_DESIRED_RSSI_dBm + 160) * 2, (AM_FIX_DESIRED_RSSI_dBm + 160) * 2};
 
 int8_t currentGainDiff;
 bool enabled = true;
 
+// gain_table_index_prev[] value that forces the next REG_13 write
+#define AM_FIX_INDEX_UNKNOWN  0xFF
+
 void AM_fix_init(void)
 {	// called at boot-up
 	for (int i = 0; i < 2; i++) {
 		gain_table_index[i] = 0;  // re-start with original QS setting
+		gain_table_index_prev[i] = AM_FIX_INDEX_UNKNOWN;
 	}
-#if !LOOKUP_TABLE
-	CreateTable();
-#endif
 }
 
 void AM_fix_reset(const unsigned vfo)
@@ -247,8 +268,20 @@ void AM_fix_reset(const unsigned vfo)
 	#endif
 
 	prev_rssi[vfo] = 0;
+	level[vfo] = 0;
 	hold_counter[vfo] = 0;
-	gain_table_index_prev[vfo] = 0;
+	settle_counter[vfo] = 0;
+	gain_table_index_prev[vfo] = AM_FIX_INDEX_UNKNOWN;
+}
+
+// find the highest gain table entry that doesn't exceed the wanted gain,
+// the wanted gain normally falls between two entries so we round down
+static unsigned int find_gain_index(const int16_t gain_dB)
+{
+	unsigned int index = 1;
+	while (index < gain_table_size - 1u && gain_table[index + 1].gain_dB <= gain_dB)
+		index++;
+	return index;
 }
 
 // adjust the RX gain to try and prevent the AM demodulator from
@@ -258,15 +291,30 @@ void AM_fix_reset(const unsigned vfo)
 // won't/don't do it for itself, we're left to bodging it ourself by
 // playing with the RF front end gain setting
 //
-void AM_fix_10ms(const unsigned vfo)
+// the RSSI is first referred back to the front end input by removing the
+// gain we currently have set, that level is filtered with a fast attack and
+// slow decay, then the gain that puts the filtered level at the wanted RSSI
+// is looked up in the gain table
+//
+// with ENABLE_SOFT_AGC the same is done for FM/SSB, each with its own target
+//
+void AM_fix_10ms(const unsigned vfo, const ModulationMode_t modulation)
 {
-	if(!gSetting_AM_fix || !enabled || vfo > 1 )
+	if(vfo > 1)
+		return;
+
+	if(!AM_fix_active(modulation) || !enabled) {
+		// the registers may get changed behind our back while we're not
+		// running, so make sure we write them again once we are
+		gain_table_index_prev[vfo] = AM_FIX_INDEX_UNKNOWN;
 		return;
+	}
 
 	if (gCurrentFunction != FUNCTION_FOREGROUND && !FUNCTION_IsRx()) {
 #ifdef ENABLE_AM_FIX_SHOW_DATA
 		counter = display_update_rate;  // queue up a display update as soon as we switch to RX mode
 #endif
+		gain_table_index_prev[vfo] = AM_FIX_INDEX_UNKNOWN;
 		return;
 	}
 
@@ -279,87 +327,79 @@ void AM_fix_10ms(const unsigned vfo)
 	}
 #endif
 
-	static uint32_t lastFreq[2];
-	if(gEeprom.VfoInfo[vfo].pRX->Frequency != lastFreq[vfo]) {
-		lastFreq[vfo] = gEeprom.VfoInfo[vfo].pRX->Frequency;
+	static uint32_t         lastFreq[2];
+	static ModulationMode_t lastModulation[2];
+	if(gEeprom.VfoInfo[vfo].pRX->Frequency != lastFreq[vfo] || modulation != lastModulation[vfo]) {
+		lastFreq[vfo]       = gEeprom.VfoInfo[vfo].pRX->Frequency;
+		lastModulation[vfo] = modulation;
+		desired_rssi[vfo]   = (desired_rssi_mod_dBm[modulation] + desired_rssi_band_dB[FREQUENCY_GetBand(lastFreq[vfo])] + 160) * 2;
 		AM_fix_reset(vfo);
 	}
 
-	int16_t rssi;
-	{	// sample the current RSSI level
-		// average it with the previous rssi (a bit of noise/spike immunity)
-		const int16_t new_rssi = BK4819_GetRSSI();
-		rssi                   = (prev_rssi[vfo] > 0) ? (prev_rssi[vfo] + new_rssi) / 2 : new_rssi;
-		prev_rssi[vfo]         = new_rssi;
+	// update the gain hold counter
+	if (hold_counter[vfo] > 0)
+		hold_counter[vfo]--;
+
+	if (settle_counter[vfo] > 0) {
+		settle_counter[vfo]--;
 	}
+	else {
+		// sample the current RSSI level (shared with everyone else this tick)
+		const int16_t rssi = RADIO_GetRawRssi();
 
 #ifdef ENABLE_AM_FIX_SHOW_DATA
-	{
-		static int16_t lastRssi;
-
-		if (lastRssi != rssi) { // rssi changed
-			lastRssi = rssi;
-
-			if (counter == 0) {
-				counter        = 1;
-				gUpdateDisplay = true; // trigger a display update
-			}
+		if (prev_rssi[vfo] != rssi && counter == 0) { // rssi changed
+			counter        = 1;
+			gUpdateDisplay = true; // trigger a display update
 		}
-	}
 #endif
+		prev_rssi[vfo] = rssi;
 
-	// automatically adjust the RF RX gain
-
-	// update the gain hold counter
-	if (hold_counter[vfo] > 0)
-		hold_counter[vfo]--;
-
-	// dB difference between actual and desired RSSI level
-	int16_t diff_dB = (rssi - desired_rssi) / 2;
+		// RX level at the front end input
+		const int32_t new_level = (int32_t)(rssi - gain_table[gain_table_index[vfo]].gain_dB * 2) << AM_FIX_LEVEL_FRAC;
 
-	if (diff_dB > 0) {	// decrease gain
-		unsigned int index = gain_table_index[vfo];   // current position we're at
+		if (level[vfo] == 0)
+			level[vfo] = new_level;    // first reading
+		else if (new_level > level[vfo])
+			level[vfo] += (new_level - level[vfo]) >> AM_FIX_ATTACK_SHIFT;
+		else
+			level[vfo] -= (level[vfo] - new_level) >> AM_FIX_DECAY_SHIFT;
+	}
 
-		if (diff_dB >= 10) {	// jump immediately to a new gain setting
-			// this greatly speeds up initial gain reduction (but reduces noise/spike immunity)
+	if (level[vfo] != 0)
+	{	// automatically adjust the RF RX gain
 
-			const int16_t desired_gain_dB = (int16_t)gain_table[index].gain_dB - diff_dB + 8; // get no closer than 8dB (bit of noise/spike immunity)
+		// gain (dB) that puts the RSSI at the desired level
+		const int16_t wanted_gain_dB = (desired_rssi[vfo] - (level[vfo] >> AM_FIX_LEVEL_FRAC)) / 2;
+		const unsigned int current   = gain_table_index[vfo];
+		unsigned int index           = find_gain_index(wanted_gain_dB);
 
-			// scan the table to see what index to jump straight too
-			while (index > 1)
-				if (gain_table[--index].gain_dB <= desired_gain_dB)
-					break;
+		if (current == 0 || gain_table[index].gain_dB < gain_table[current].gain_dB) {
+			// decrease gain, jump immediately to the new gain setting
+			hold_counter[vfo] = AM_FIX_HOLD_10ms;
 		}
-		else
-		{	// incrementally reduce the gain .. taking it slow improves noise/spike immunity
-			if (index > 1)
-				index--;     // slow step-by-step gain reduction
+		else if (index > current &&
+		         hold_counter[vfo] == 0 &&
+		         gain_table[current + 1].gain_dB <= wanted_gain_dB - AM_FIX_HYSTERESIS_dB) {
+			// hold has been released, we're free to slowly increase gain
+			index = current + 1;
 		}
-
-		index = MAX(1u, index);
-
-		if (gain_table_index[vfo] != index)
-		{
-			gain_table_index[vfo] = index;
-			hold_counter[vfo] = 30;       // 300ms hold
+		else {
+			index = current;
 		}
-	}
 
-	if (diff_dB >= -6)                    // 6dB hysterisis (help reduce gain hunting)
-		hold_counter[vfo] = 30;           // 300ms hold
-
-	if (hold_counter[vfo] == 0)
-	{	// hold has been released, we're free to increase gain
-		const unsigned int index = gain_table_index[vfo] + 1;                 // move up to next gain index
-		gain_table_index[vfo] = MIN(index, gain_table_size - 1u);
+		gain_table_index[vfo] = index;
 	}
 
-
 	{	// apply the new settings to the front end registers
 		const unsigned int index = gain_table_index[vfo];
 
+		if (index == gain_table_index_prev[vfo])
+			return;    // no change, save ourselves the SPI transaction
+
 		// remember the new table index
 		gain_table_index_prev[vfo] = index;
+		settle_counter[vfo] = AM_FIX_SETTLE_10ms;
 		currentGainDiff = gain_table[0].gain_dB - gain_table[index].gain_dB;
 		BK4819_WriteRegister(BK4819_REG_13, gain_table[index].reg_val);
 #ifdef ENABLE_AGC_SHOW_DATA
@@ -385,6 +425,20 @@ void AM_fix_print_data(const unsigned vfo, char *s) {
 }
 #endif
 
+bool AM_fix_active(const ModulationMode_t modulation)
+{
+	return gSetting_AM_fix && modulation < MODULATION_UKNOWN && desired_rssi_mod_dBm[modulation] != 0;
+}
+
+bool AM_fix_overloaded(const unsigned vfo)
+{	// even the lowest gain setting can't bring the signal down to the
+	// wanted level, the front end is being overloaded
+	if (vfo > 1 || !enabled || level[vfo] == 0 || gain_table_index[vfo] != 1)
+		return false;
+	const int16_t rssi = (level[vfo] >> AM_FIX_LEVEL_FRAC) + gain_table[1].gain_dB * 2;
+	return rssi > desired_rssi[vfo] + AM_FIX_HYSTERESIS_dB * 2;
+}
+
 int8_t AM_fix_get_gain_diff()
 {
 	return currentGainDiff;
@@ -392,6 +446,11 @@ int8_t AM_fix_get_gain_diff()
 
 void AM_fix_enable(bool on)
 {
+	if (on && !enabled) {
+		// someone else may have been playing with the front end gain
+		gain_table_index_prev[0] = AM_FIX_INDEX_UNKNOWN;
+		gain_table_index_prev[1] = AM_FIX_INDEX_UNKNOWN;
+	}
 	enabled = on;
 }
 #endif
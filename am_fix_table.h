@@ -0,0 +1,105 @@
+// generated by utils/am_fix_table.py - do not edit
+//
+// index .. LNA-S LNA MIXER PGA .. gain
+
+#ifndef AM_FIX_TABLE_H
+#define AM_FIX_TABLE_H
+
+static const t_gain_table gain_table[] =
+{
+	{0x03BE,  -7},  //  0 .. original
+
+	{0x0000, -93},  //  1 .. 0 0 0 0 .. -93dB
+	{0x0008, -91},  //  2 .. 0 0 1 0 .. -91dB
+	{0x0100, -89},  //  3 .. 1 0 0 0 .. -89dB
+	{0x0010, -88},  //  4 .. 0 0 2 0 .. -88dB
+	{0x0001, -87},  //  5 .. 0 0 0 1 .. -87dB
+	{0x0028, -86},  //  6 .. 0 1 1 0 .. -86dB
+	{0x0009, -85},  //  7 .. 0 0 1 1 .. -85dB
+	{0x0110, -84},  //  8 .. 1 0 2 0 .. -84dB
+	{0x0030, -83},  //  9 .. 0 1 2 0 .. -83dB
+	{0x0011, -82},  // 10 .. 0 0 2 1 .. -82dB
+	{0x0002, -81},  // 11 .. 0 0 0 2 .. -81dB
+	{0x0029, -80},  // 12 .. 0 1 1 1 .. -80dB
+	{0x000A, -79},  // 13 .. 0 0 1 2 .. -79dB
+	{0x0050, -78},  // 14 .. 0 2 2 0 .. -78dB
+	{0x0031, -77},  // 15 .. 0 1 2 1 .. -77dB
+	{0x0012, -76},  // 16 .. 0 0 2 2 .. -76dB
+	{0x0003, -75},  // 17 .. 0 0 0 3 .. -75dB
+	{0x002A, -74},  // 18 .. 0 1 1 2 .. -74dB
+	{0x000B, -73},  // 19 .. 0 0 1 3 .. -73dB
+	{0x0051, -72},  // 20 .. 0 2 2 1 .. -72dB
+	{0x0032, -71},  // 21 .. 0 1 2 2 .. -71dB
+	{0x0013, -70},  // 22 .. 0 0 2 3 .. -70dB
+	{0x0004, -69},  // 23 .. 0 0 0 4 .. -69dB
+	{0x002B, -68},  // 24 .. 0 1 1 3 .. -68dB
+	{0x000C, -67},  // 25 .. 0 0 1 4 .. -67dB
+	{0x0005, -66},  // 26 .. 0 0 0 5 .. -66dB
+	{0x0033, -65},  // 27 .. 0 1 2 3 .. -65dB
+	{0x000D, -64},  // 28 .. 0 0 1 5 .. -64dB
+	{0x0006, -63},  // 29 .. 0 0 0 6 .. -63dB
+	{0x002C, -62},  // 30 .. 0 1 1 4 .. -62dB
+	{0x000E, -61},  // 31 .. 0 0 1 6 .. -61dB
+	{0x0007, -60},  // 32 .. 0 0 0 7 .. -60dB
+	{0x002D, -59},  // 33 .. 0 1 1 5 .. -59dB
+	{0x000F, -58},  // 34 .. 0 0 1 7 .. -58dB
+	{0x004C, -57},  // 35 .. 0 2 1 4 .. -57dB
+	{0x002E, -56},  // 36 .. 0 1 1 6 .. -56dB
+	{0x0017, -55},  // 37 .. 0 0 2 7 .. -55dB
+	{0x004D, -54},  // 38 .. 0 2 1 5 .. -54dB
+	{0x002F, -53},  // 39 .. 0 1 1 7 .. -53dB
+	{0x001F, -52},  // 40 .. 0 0 3 7 .. -52dB
+	{0x004E, -51},  // 41 .. 0 2 1 6 .. -51dB
+	{0x0037, -50},  // 42 .. 0 1 2 7 .. -50dB
+	{0x006D, -49},  // 43 .. 0 3 1 5 .. -49dB
+	{0x004F, -48},  // 44 .. 0 2 1 7 .. -48dB
+	{0x003F, -47},  // 45 .. 0 1 3 7 .. -47dB
+	{0x006E, -46},  // 46 .. 0 3 1 6 .. -46dB
+	{0x0057, -45},  // 47 .. 0 2 2 7 .. -45dB
+	{0x00AD, -44},  // 48 .. 0 5 1 5 .. -44dB
+	{0x006F, -43},  // 49 .. 0 3 1 7 .. -43dB
+	{0x005F, -42},  // 50 .. 0 2 3 7 .. -42dB
+	{0x00AE, -41},  // 51 .. 0 5 1 6 .. -41dB
+	{0x0077, -40},  // 52 .. 0 3 2 7 .. -40dB
+	{0x00CE, -39},  // 53 .. 0 6 1 6 .. -39dB
+	{0x00AF, -38},  // 54 .. 0 5 1 7 .. -38dB
+	{0x007F, -37},  // 55 .. 0 3 3 7 .. -37dB
+	{0x00CF, -36},  // 56 .. 0 6 1 7 .. -36dB
+	{0x00B7, -35},  // 57 .. 0 5 2 7 .. -35dB
+	{0x009F, -34},  // 58 .. 0 4 3 7 .. -34dB
+	{0x00D7, -33},  // 59 .. 0 6 2 7 .. -33dB
+	{0x00BF, -32},  // 60 .. 0 5 3 7 .. -32dB
+	{0x00F7, -31},  // 61 .. 0 7 2 7 .. -31dB
+	{0x00DF, -30},  // 62 .. 0 6 3 7 .. -30dB
+	{0x01D7, -29},  // 63 .. 1 6 2 7 .. -29dB
+	{0x00FF, -28},  // 64 .. 0 7 3 7 .. -28dB
+	{0x01F7, -27},  // 65 .. 1 7 2 7 .. -27dB
+	{0x01DF, -26},  // 66 .. 1 6 3 7 .. -26dB
+	{0x029F, -25},  // 67 .. 2 4 3 7 .. -25dB
+	{0x01FF, -24},  // 68 .. 1 7 3 7 .. -24dB
+	{0x02BF, -23},  // 69 .. 2 5 3 7 .. -23dB
+	{0x02F7, -22},  // 70 .. 2 7 2 7 .. -22dB
+	{0x02DF, -21},  // 71 .. 2 6 3 7 .. -21dB
+	{0x034F, -20},  // 72 .. 3 2 1 7 .. -20dB
+	{0x02FF, -19},  // 73 .. 2 7 3 7 .. -19dB
+	{0x036E, -18},  // 74 .. 3 3 1 6 .. -18dB
+	{0x0357, -17},  // 75 .. 3 2 2 7 .. -17dB
+	{0x03AD, -16},  // 76 .. 3 5 1 5 .. -16dB
+	{0x036F, -15},  // 77 .. 3 3 1 7 .. -15dB
+	{0x035F, -14},  // 78 .. 3 2 3 7 .. -14dB
+	{0x03AE, -13},  // 79 .. 3 5 1 6 .. -13dB
+	{0x0377, -12},  // 80 .. 3 3 2 7 .. -12dB
+	{0x03CE, -11},  // 81 .. 3 6 1 6 .. -11dB
+	{0x03AF, -10},  // 82 .. 3 5 1 7 .. -10dB
+	{0x037F,  -9},  // 83 .. 3 3 3 7 ..  -9dB
+	{0x03CF,  -8},  // 84 .. 3 6 1 7 ..  -8dB
+	{0x03B7,  -7},  // 85 .. 3 5 2 7 ..  -7dB
+	{0x039F,  -6},  // 86 .. 3 4 3 7 ..  -6dB
+	{0x03D7,  -5},  // 87 .. 3 6 2 7 ..  -5dB
+	{0x03BF,  -4},  // 88 .. 3 5 3 7 ..  -4dB
+	{0x03F7,  -3},  // 89 .. 3 7 2 7 ..  -3dB
+	{0x03DF,  -2},  // 90 .. 3 6 3 7 ..  -2dB
+	{0x03FF,   0}   // 91 .. 3 7 3 7 ..   0dB
+};
+
+#endif
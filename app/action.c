@@ -28,6 +28,9 @@
 #ifdef ENABLE_FMRADIO
 	#include "app/fm.h"
 #endif
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	#include "app/main.h"
+#endif
 #include "app/scanner.h"
 #include "audio.h"
 #include "bsp/dp32g030/gpio.h"
@@ -110,6 +113,18 @@ void (*action_opt_table[])(void) = {
 #else
 	[ACTION_OPT_SPECTRUM] = &FUNCTION_NOP,
 #endif
+
+#ifdef ENABLE_BACKLIGHT_FADE
+	[ACTION_OPT_BL_NIGHT] = &ACTION_BacklightNight,
+#else
+	[ACTION_OPT_BL_NIGHT] = &FUNCTION_NOP,
+#endif
+
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	[ACTION_OPT_NAME_SEARCH] = &MAIN_ToggleNameSearch,
+#else
+	[ACTION_OPT_NAME_SEARCH] = &FUNCTION_NOP,
+#endif
 };
 
 static_assert(ARRAY_SIZE(action_opt_table) == ACTION_OPT_LEN);
@@ -450,4 +465,12 @@ void ACTION_BlminTmpOff(void)
 		BACKLIGHT_SetBrightness(0);
 	}
 }
-#endif
\ No newline at end of file
+#endif
+
+#ifdef ENABLE_BACKLIGHT_FADE
+void ACTION_BacklightNight(void)
+{
+	gBacklightNight = !gBacklightNight;
+	BACKLIGHT_TurnOn();
+}
+#endif
@@ -35,6 +35,10 @@ void ACTION_SwitchDemodul(void);
 void ACTION_BlminTmpOff(void);
 #endif
 
+#ifdef ENABLE_BACKLIGHT_FADE
+void ACTION_BacklightNight(void);
+#endif
+
 void ACTION_Handle(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 
 #endif
@@ -16,7 +16,10 @@
 
 #ifdef ENABLE_AIRCOPY
 
+#include <string.h>
+
 #include "app/aircopy.h"
+#include "app/fsk.h"
 #include "audio.h"
 #include "driver/bk4819.h"
 #include "driver/crc.h"
@@ -33,94 +36,206 @@ static const uint16_t Obfuscation[8] = { 0x6C16, 0xE614, 0x912E, 0x400D, 0x3521,
 AIRCOPY_State_t gAircopyState;
 uint16_t gAirCopyBlockNumber;
 uint16_t gErrorsDuringAirCopy;
+uint16_t gAirCopyResends;
 uint8_t gAirCopyIsSendMode;
 
-uint16_t g_FSK_Buffer[36];
+#define AIRCOPY_BLOCKS            0x78    // 64 bytes each, EEPROM 0x0000 to 0x1DFF
+// extra gap between blocks, a receiver (the original firmware or ours) needs
+// it to write a block to the EEPROM (8 writes, ~64ms) and re-arm its receiver
+#define AIRCOPY_BLOCK_GAP_10ms    6
+// receiver: quiet time after the last block before it sends its block map,
+// longer than a couple of lost blocks (~640ms each) so the map doesn't go
+// out half way through a pass, then repeated in case the map got lost
+#define AIRCOPY_QUIET_10ms        250
+#define AIRCOPY_MAP_REPEAT_10ms   100
+#define AIRCOPY_MAP_REPEATS       3
+// sender: how long to wait for the block map after a pass, long enough to
+// hear the last of the receiver's repeats
+#define AIRCOPY_MAP_WAIT_10ms     (AIRCOPY_QUIET_10ms + (AIRCOPY_MAP_REPEAT_10ms * AIRCOPY_MAP_REPEATS))
+#define AIRCOPY_MAX_PASSES        8
+
+// blocks the receiver has, the sender keeps the receiver's copy of it
+static uint8_t  blockMap[(AIRCOPY_BLOCKS + 7) / 8];
+static uint8_t  sendBlock;
+static uint8_t  sendPass;
+static uint16_t timer_10ms;
+static uint16_t lastFskErrors;
+static uint8_t  mapsLeft;
+
+static bool HaveBlock(const unsigned int block)
+{
+	return (blockMap[block / 8] >> (block % 8)) & 1u;
+}
 
-bool AIRCOPY_SendMessage(void)
+static unsigned int CountBlocks(void)
 {
-	static uint8_t gAircopySendCountdown = 1;
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < AIRCOPY_BLOCKS; i++) {
+		count += HaveBlock(i);
+	}
+	return count;
+}
 
-	if (gAircopyState != AIRCOPY_TRANSFER) {
-		return 1;
+static bool SendBlock(const unsigned int block)
+{
+	uint16_t payload[FSK_LEGACY_PAYLOAD / 2];
+
+	payload[0] = (block & 0x3FF) << 6;
+
+	EEPROM_ReadBuffer(payload[0], &payload[1], 64);
+
+	payload[33] = CRC_Calculate(&payload[0], 2 + 64);
+
+	for (unsigned int i = 0; i < 34; i++) {
+		payload[i] ^= Obfuscation[i % 8];
 	}
 
-	if (--gAircopySendCountdown) {
+	return FSK_Send(FSK_TYPE_LEGACY, payload, sizeof(payload));
+}
+
+bool AIRCOPY_SendMessage(void)
+{
+	if (gAircopyState != AIRCOPY_TRANSFER) {
 		return 1;
 	}
 
-	g_FSK_Buffer[1] = (gAirCopyBlockNumber & 0x3FF) << 6;
+	if (sendBlock < AIRCOPY_BLOCKS) {
+		// keep the FSK queue topped up, the next block goes out as soon as
+		// the last one's TX finished interrupt comes in
+		while (sendBlock < AIRCOPY_BLOCKS && HaveBlock(sendBlock)) {
+			sendBlock++;
+		}
 
-	EEPROM_ReadBuffer(g_FSK_Buffer[1], &g_FSK_Buffer[2], 64);
+		if (sendBlock >= AIRCOPY_BLOCKS || !SendBlock(sendBlock)) {
+			return 1;
+		}
 
-	g_FSK_Buffer[34] = CRC_Calculate(&g_FSK_Buffer[1], 2 + 64);
+		sendBlock++;
+		if (sendPass == 0) {
+			gAirCopyBlockNumber++;
+		} else {
+			gAirCopyResends++;
+		}
+		return 0;
+	}
 
-	for (unsigned int i = 0; i < 34; i++) {
-		g_FSK_Buffer[i + 1] ^= Obfuscation[i % 8];
+	if (FSK_TxBusy()) {
+		return 1;
 	}
 
-	if (++gAirCopyBlockNumber >= 0x78) {
-		gAircopyState = AIRCOPY_COMPLETE;
+	if (timer_10ms == 0) {
+		// pass done, ask around what's missing
+		FSK_StartRx();
+		timer_10ms = AIRCOPY_MAP_WAIT_10ms;
+		return 1;
 	}
 
-	RADIO_SetTxParameters();
+	FSK_Frame_t frame;
+	while (FSK_Receive(&frame)) {
+		if (frame.type != FSK_TYPE_AIRCOPY_MAP || frame.length != sizeof(blockMap)) {
+			continue;
+		}
 
-	BK4819_SendFSKData(g_FSK_Buffer);
-	BK4819_SetupPowerAmplifier(0, 0);
-	BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
+		memcpy(blockMap, frame.payload, sizeof(blockMap));
+		FSK_StopRx();
+		timer_10ms = 0;
 
-	gAircopySendCountdown = 30;
+		// what the receiver has, resends are counted on their own
+		gAirCopyBlockNumber = CountBlocks();
 
-	return 0;
-}
+		if (CountBlocks() == AIRCOPY_BLOCKS || ++sendPass >= AIRCOPY_MAX_PASSES) {
+			gAircopyState = AIRCOPY_COMPLETE;
+			return 0;
+		}
 
-void AIRCOPY_StorePacket(void)
-{
-	if (gFSKWriteIndex < 36) {
-		return;
+		// it's running this firmware, send it what's missing
+		sendBlock = 0;
+		return 0;
 	}
 
-	gFSKWriteIndex = 0;
-	gUpdateDisplay = true;
-	uint16_t Status = BK4819_ReadRegister(BK4819_REG_0B);
-	BK4819_PrepareFSKReceive();
+	if (--timer_10ms == 0) {
+		// no answer, the original firmware never sends one
+		FSK_StopRx();
+		gAircopyState = AIRCOPY_COMPLETE;
+		return 0;
+	}
 
-	// Doc says bit 4 should be 1 = CRC OK, 0 = CRC FAIL, but original firmware checks for FAIL.
+	return 1;
+}
 
-	if ((Status & 0x0010U) != 0 || g_FSK_Buffer[0] != 0xABCD || g_FSK_Buffer[35] != 0xDCBA) {
-		gErrorsDuringAirCopy++;
-		return;
-	}
+static void StoreFrame(FSK_Frame_t *pFrame)
+{
+	uint16_t *payload = (uint16_t *)pFrame->payload;
 
 	for (unsigned int i = 0; i < 34; i++) {
-		g_FSK_Buffer[i + 1] ^= Obfuscation[i % 8];
+		payload[i] ^= Obfuscation[i % 8];
 	}
 
-	uint16_t CRC = CRC_Calculate(&g_FSK_Buffer[1], 2 + 64);
-	if (g_FSK_Buffer[34] != CRC) {
+	uint16_t CRC = CRC_Calculate(&payload[0], 2 + 64);
+	if (payload[33] != CRC) {
 		gErrorsDuringAirCopy++;
 		return;
 	}
 
-	uint16_t Offset = g_FSK_Buffer[1];
+	uint16_t Offset = payload[0];
 
-	if (Offset >= 0x1E00) {
+	if (Offset >= 0x1E00 || (Offset % 64) != 0) {
 		gErrorsDuringAirCopy++;
 		return;
 	}
 
-	const uint16_t *pData = &g_FSK_Buffer[2];
+	const unsigned int block = Offset / 64;
+	if (HaveBlock(block)) {
+		return;
+	}
+
+	const uint16_t *pData = &payload[1];
 	for (unsigned int i = 0; i < 8; i++) {
 		EEPROM_WriteBuffer(Offset, pData);
 		pData += 4;
 		Offset += 8;
 	}
 
-	if (Offset == 0x1E00) {
+	blockMap[block / 8] |= 1u << (block % 8);
+
+	gAirCopyBlockNumber = CountBlocks();
+	if (gAirCopyBlockNumber == AIRCOPY_BLOCKS) {
 		gAircopyState = AIRCOPY_COMPLETE;
 	}
+}
+
+void AIRCOPY_ReceiveMessage(void)
+{
+	FSK_Frame_t frame;
+
+	// frames the FSK layer threw away count as errors too
+	if (gFSK_Stats.rx_errors != lastFskErrors) {
+		gErrorsDuringAirCopy += gFSK_Stats.rx_errors - lastFskErrors;
+		lastFskErrors = gFSK_Stats.rx_errors;
+		gUpdateDisplay = true;
+	}
+
+	while (FSK_Receive(&frame)) {
+		if (frame.type != FSK_TYPE_LEGACY) {
+			continue;
+		}
+
+		gUpdateDisplay = true;
+		timer_10ms = AIRCOPY_QUIET_10ms;
+		mapsLeft = AIRCOPY_MAP_REPEATS;
 
-	gAirCopyBlockNumber++;
+		if (gAircopyState == AIRCOPY_TRANSFER) {
+			StoreFrame(&frame);
+		}
+	}
+
+	// the sender went quiet, tell it what's missing (or that we're done)
+	if (timer_10ms > 0 && --timer_10ms == 0 && mapsLeft > 0) {
+		FSK_Send(FSK_TYPE_AIRCOPY_MAP, blockMap, sizeof(blockMap));
+		if (--mapsLeft > 0) {
+			timer_10ms = AIRCOPY_MAP_REPEAT_10ms;
+		}
+	}
 }
 
 static void AIRCOPY_Key_DIGITS(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
@@ -163,8 +278,7 @@ static void AIRCOPY_Key_DIGITS(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 		RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
 		gCurrentVfo = gRxVfo;
 		RADIO_SetupRegisters(true);
-		BK4819_SetupAircopy();
-		BK4819_ResetFSK();
+		FSK_Init();
 		return;
 	}
 
@@ -178,13 +292,16 @@ static void AIRCOPY_Key_EXIT(bool bKeyPressed, bool bKeyHeld)
 	}
 
 	if (gInputBoxIndex == 0) {
-		gFSKWriteIndex = 0;
 		gAirCopyBlockNumber = 0;
 		gInputBoxIndex = 0;
 		gErrorsDuringAirCopy = 0;
+		gAirCopyResends = 0;
 		gAirCopyIsSendMode = 0;
+		lastFskErrors = gFSK_Stats.rx_errors;
+		memset(blockMap, 0, sizeof(blockMap));
+		timer_10ms = 0;
 
-		BK4819_PrepareFSKReceive();
+		FSK_StartRx();
 
 		gAircopyState = AIRCOPY_TRANSFER;
 	} else {
@@ -200,13 +317,15 @@ static void AIRCOPY_Key_MENU(bool bKeyPressed, bool bKeyHeld)
 		return;
 	}
 
-	gFSKWriteIndex = 0;
 	gAirCopyBlockNumber = 0;
+	gAirCopyResends = 0;
 	gInputBoxIndex = 0;
 	gAirCopyIsSendMode = 1;
-	g_FSK_Buffer[0] = 0xABCD;
-	g_FSK_Buffer[1] = 0;
-	g_FSK_Buffer[35] = 0xDCBA;
+	memset(blockMap, 0, sizeof(blockMap));
+	sendBlock = 0;
+	sendPass = 0;
+	timer_10ms = 0;
+	FSK_SetTxGap(AIRCOPY_BLOCK_GAP_10ms);
 
 	GUI_DisplayScreen();
 
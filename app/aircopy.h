@@ -33,12 +33,11 @@ typedef enum AIRCOPY_State_t AIRCOPY_State_t;
 extern AIRCOPY_State_t gAircopyState;
 extern uint16_t        gAirCopyBlockNumber;
 extern uint16_t        gErrorsDuringAirCopy;
+extern uint16_t        gAirCopyResends;
 extern uint8_t         gAirCopyIsSendMode;
 
-extern uint16_t        g_FSK_Buffer[36];
-
 bool AIRCOPY_SendMessage(void);
-void AIRCOPY_StorePacket(void);
+void AIRCOPY_ReceiveMessage(void);
 void AIRCOPY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 
 #endif
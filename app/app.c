@@ -33,10 +33,16 @@
 #ifdef ENABLE_FMRADIO
 	#include "app/fm.h"
 #endif
+#ifdef ENABLE_FSK_PACKETS
+	#include "app/fsk.h"
+#endif
 #include "app/generic.h"
 #include "app/main.h"
 #include "app/menu.h"
 #include "app/scanner.h"
+#ifdef ENABLE_SW_VOX
+	#include "app/vox.h"
+#endif
 #ifdef ENABLE_UART
 	#include "app/uart.h"
 #endif
@@ -49,6 +55,7 @@
 	#include "driver/bk1080.h"
 #endif
 #include "driver/bk4819.h"
+#include "driver/eeprom.h"
 #include "driver/gpio.h"
 #include "driver/keyboard.h"
 #include "driver/st7565.h"
@@ -58,9 +65,12 @@
 #include "frequencies.h"
 #include "functions.h"
 #include "helper/battery.h"
+#include "key_queue.h"
 #include "misc.h"
 #include "radio.h"
+#include "power_save.h"
 #include "settings.h"
+#include "tail.h"
 
 #if defined(ENABLE_OVERLAY)
 	#include "sram-overlay.h"
@@ -350,6 +360,7 @@ Skip:
 			break;
 
 		case END_OF_RX_MODE_END:
+			TAIL_RxEnd();
 			RADIO_SetupRegisters(true);
 
 #ifdef ENABLE_NOAA
@@ -377,14 +388,8 @@ Skip:
 			break;
 
 		case END_OF_RX_MODE_TTE:
-			if (gEeprom.TAIL_TONE_ELIMINATION) {
-				AUDIO_AudioPathOff();
-
-				gTailToneEliminationCountdown_10ms = 20;
-				gFlagTailToneEliminationComplete   = false;
-				gEndOfRxDetectedMaybe = true;
-				gEnableSpeaker        = false;
-			}
+			if (gEeprom.TAIL_TONE_ELIMINATION)
+				TAIL_RxMute();
 			break;
 	}
 }
@@ -558,6 +563,98 @@ static void DualwatchAlternate(void)
 	#endif
 }
 
+static void HandleRxDTMFCharacter(const char c)
+{
+	if (gCurrentFunction == FUNCTION_TRANSMIT)
+		return;
+
+	POWERSAVE_Activity();
+
+	if (gSetting_live_DTMF_decoder) {
+		size_t len = strlen(gDTMF_RX_live);
+		if (len >= sizeof(gDTMF_RX_live) - 1) { // make room
+			memmove(&gDTMF_RX_live[0], &gDTMF_RX_live[1], sizeof(gDTMF_RX_live) - 1);
+			len--;
+		}
+		gDTMF_RX_live[len++]  = c;
+		gDTMF_RX_live[len]    = 0;
+		gDTMF_RX_live_timeout = DTMF_RX_live_timeout_500ms;  // time till we delete it
+		gUpdateDisplay        = true;
+	}
+
+#ifdef ENABLE_DTMF_CALLING
+	if (gRxVfo->DTMF_DECODING_ENABLE || gSetting_KILLED) {
+		if (gDTMF_RX_index >= sizeof(gDTMF_RX) - 1) { // make room
+			memmove(&gDTMF_RX[0], &gDTMF_RX[1], sizeof(gDTMF_RX) - 1);
+			gDTMF_RX_index--;
+		}
+		gDTMF_RX[gDTMF_RX_index++] = c;
+		gDTMF_RX[gDTMF_RX_index]   = 0;
+		gDTMF_RX_timeout           = DTMF_RX_timeout_500ms;  // time till we delete it
+		gDTMF_RX_pending           = true;
+
+		SYSTEM_DelayMs(3);//fix DTMF not reply@Yurisu
+		DTMF_HandleRequest();
+	}
+#endif
+}
+
+#ifdef ENABLE_VOX
+// mic level's up, stay awake and hold dual watch while HandleVox() decides
+static void VoxWake(void)
+{
+	if (!gEeprom.VOX_SWITCH)
+		return;
+
+	if (gCurrentFunction == FUNCTION_POWER_SAVE && !gRxIdleMode) {
+		gPowerSave_10ms            = power_save2_10ms;
+		gPowerSaveCountdownExpired = 0;
+	}
+
+	if (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF && (gScheduleDualWatch || gDualWatchCountdown_10ms < dual_watch_count_after_vox_10ms)) {
+		gDualWatchCountdown_10ms = dual_watch_count_after_vox_10ms;
+		gScheduleDualWatch = false;
+
+		// let the user see DW is not active
+		gDualWatchActive = false;
+		gUpdateStatus    = true;
+	}
+}
+#endif
+
+#ifdef ENABLE_SW_VOX
+static void CheckVox(void)
+{
+	uint16_t Amp;
+
+	if (!VOX_IsRunning())
+		return;
+
+	BK4819_GetVoxAmp(&Amp);
+
+	switch (VOX_Sample(Amp)) {
+		case VOX_EVENT_ARM:
+			// get the radio ready to key up while the detector makes its mind up
+			VoxWake();
+			break;
+
+		case VOX_EVENT_START:
+			g_VOX_Lost         = true;
+			gVoxPauseCountdown = 0;   // already past the attack time, no need to wait any more
+			break;
+
+		case VOX_EVENT_STOP:
+			POWERSAVE_Activity();
+			g_VOX_Lost         = false;
+			gVoxPauseCountdown = 0;
+			break;
+
+		default:
+			break;
+	}
+}
+#endif
+
 static void CheckRadioInterrupts(void)
 {
 	if (SCANNER_IsScanning())
@@ -600,39 +697,10 @@ static void CheckRadioInterrupts(void)
 //		if (ctcss_shift > 0)
 //			g_CTCSS_Lost = true;
 
-		if (interrupts.dtmf5ToneFound) {	
+		if (interrupts.dtmf5ToneFound) {
 			const char c = DTMF_GetCharacter(BK4819_GetDTMF_5TONE_Code()); // save the RX'ed DTMF character
-			if (c != 0xff) {
-				if (gCurrentFunction != FUNCTION_TRANSMIT) {
-					if (gSetting_live_DTMF_decoder) {
-						size_t len = strlen(gDTMF_RX_live);
-						if (len >= sizeof(gDTMF_RX_live) - 1) { // make room
-							memmove(&gDTMF_RX_live[0], &gDTMF_RX_live[1], sizeof(gDTMF_RX_live) - 1);
-							len--;
-						}
-						gDTMF_RX_live[len++]  = c;
-						gDTMF_RX_live[len]    = 0;
-						gDTMF_RX_live_timeout = DTMF_RX_live_timeout_500ms;  // time till we delete it
-						gUpdateDisplay        = true;
-					}
-
-#ifdef ENABLE_DTMF_CALLING
-					if (gRxVfo->DTMF_DECODING_ENABLE || gSetting_KILLED) {
-						if (gDTMF_RX_index >= sizeof(gDTMF_RX) - 1) { // make room
-							memmove(&gDTMF_RX[0], &gDTMF_RX[1], sizeof(gDTMF_RX) - 1);
-							gDTMF_RX_index--;
-						}
-						gDTMF_RX[gDTMF_RX_index++] = c;
-						gDTMF_RX[gDTMF_RX_index]   = 0;
-						gDTMF_RX_timeout           = DTMF_RX_timeout_500ms;  // time till we delete it
-						gDTMF_RX_pending           = true;
-						
-						SYSTEM_DelayMs(3);//fix DTMF not reply@Yurisu
-						DTMF_HandleRequest();
-					}
-#endif
-				}
-			}
+			if (c != 0xff)
+				HandleRxDTMFCharacter(c);
 		}
 
 		if (interrupts.cssTailFound)
@@ -656,25 +724,11 @@ static void CheckRadioInterrupts(void)
 		if (interrupts.voxLost) {
 			g_VOX_Lost         = true;
 			gVoxPauseCountdown = 10;
-
-			if (gEeprom.VOX_SWITCH) {
-				if (gCurrentFunction == FUNCTION_POWER_SAVE && !gRxIdleMode) {
-					gPowerSave_10ms            = power_save2_10ms;
-					gPowerSaveCountdownExpired = 0;
-				}
-
-				if (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF && (gScheduleDualWatch || gDualWatchCountdown_10ms < dual_watch_count_after_vox_10ms)) {
-					gDualWatchCountdown_10ms = dual_watch_count_after_vox_10ms;
-					gScheduleDualWatch = false;
-
-					// let the user see DW is not active
-					gDualWatchActive = false;
-					gUpdateStatus    = true;
-				}
-			}
+			VoxWake();
 		}
 
 		if (interrupts.voxFound) {
+			POWERSAVE_Activity();
 			g_VOX_Lost         = false;
 			gVoxPauseCountdown = 0;
 		}
@@ -682,6 +736,7 @@ static void CheckRadioInterrupts(void)
 
 		if (interrupts.sqlLost) {
 			g_SquelchLost = true;
+			POWERSAVE_Activity();
 			BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, true);
 		}
 
@@ -690,18 +745,10 @@ static void CheckRadioInterrupts(void)
 			BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, false);
 		}
 
-#ifdef ENABLE_AIRCOPY
-		if (interrupts.fskFifoAlmostFull &&
-			gScreenToDisplay == DISPLAY_AIRCOPY &&
-			gAircopyState == AIRCOPY_TRANSFER &&
-			gAirCopyIsSendMode == 0)
-		{
-			for (unsigned int i = 0; i < 4; i++) {
-				g_FSK_Buffer[gFSKWriteIndex++] = BK4819_ReadRegister(BK4819_REG_5F);
-			}
+		TAIL_HandleInterrupt(interrupts.__raw);
 
-			AIRCOPY_StorePacket();
-		}
+#ifdef ENABLE_FSK_PACKETS
+		FSK_HandleInterrupt(interrupts.__raw);
 #endif
 	}
 }
@@ -760,13 +807,7 @@ static void HandleVox(void)
 			}
 			else {
 				APP_EndTransmission();
-
-				if (gEeprom.REPEATER_TAIL_TONE_ELIMINATION == 0) {
-					//if (gCurrentFunction != FUNCTION_FOREGROUND)
-						FUNCTION_Select(FUNCTION_FOREGROUND);
-				}
-				else
-					gRTTECountdown_10ms = gEeprom.REPEATER_TAIL_TONE_ELIMINATION * 10;
+				TAIL_StartRepeaterHold();
 			}
 
 			gUpdateStatus        = true;
@@ -893,6 +934,15 @@ void APP_Update(void)
 		HandleVox();
 #endif
 
+#ifdef ENABLE_DEFERRED_SAVES
+	// quiet for a while, or the battery's low enough that it might not last
+	if (gScheduleEepromWrite || (gLowBattery && gEepromWriteCountdown_10ms > 0)) {
+		gEepromWriteCountdown_10ms = 0;
+		gScheduleEepromWrite       = false;
+		EEPROM_Flush();
+	}
+#endif
+
 	if (gSchedulePowerSave) {
 		if (gPttIsPressed
 			|| gKeyBeingHeld
@@ -951,7 +1001,7 @@ void APP_Update(void)
 		{	// dual watch mode off or scanning or rssi update request
 			// go back to sleep
 
-			gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
+			gPowerSave_10ms = POWERSAVE_NextSleep_10ms(gEeprom.BATTERY_SAVE);
 			gRxIdleMode     = true;
 			goToSleep = false;
 
@@ -997,7 +1047,7 @@ static void CheckKeys(void)
 			{	// stop transmitting
 				ProcessKey(KEY_PTT, false, false);
 				gPttIsPressed = false;
-				if (gKeyReading1 != KEY_INVALID)
+				if (KEYQ_KeyDown() != KEY_INVALID)
 					gPttWasReleased = true;
 			}
 		}
@@ -1019,69 +1069,35 @@ static void CheckKeys(void)
 
 // --------------------- OTHER KEYS ----------------------------
 
-	// scan the hardware keys
-	KEY_Code_t Key = KEYBOARD_Poll();
+	// scan the hardware keys, the full row by row scan only when something's down
+	const KEY_Code_t Key = KEYBOARD_AnyKeyDown() ? KEYBOARD_Poll() : KEY_INVALID;
 
 	if (Key != KEY_INVALID) // any key pressed
 		boot_counter_10ms = 0;   // cancel boot screen/beeps if any key pressed
 
-	if (gKeyReading0 != Key) // new key pressed
-	{
-
-		if (gKeyReading0 != KEY_INVALID && Key != KEY_INVALID)
-			ProcessKey(gKeyReading1, false, gKeyBeingHeld);  // key pressed without releasing previous key
-
-		gKeyReading0     = Key;
-		gDebounceCounter = 0;
-		return;
-	}
-
-	gDebounceCounter++;
+	KEYQ_Scan(Key, gGlobalSysTickCounter);
 
-	if (gDebounceCounter == key_debounce_10ms) // debounced new key pressed
+	KEY_Event_t Event;
+	while (KEYQ_Get(&Event))
 	{
-		if (Key == KEY_INVALID) //all non PTT keys released
+		switch (Event.type)
 		{
-			if (gKeyReading1 != KEY_INVALID) // some button was pressed before
-			{
-				ProcessKey(gKeyReading1, false, gKeyBeingHeld); // process last button released event
-				gKeyReading1 = KEY_INVALID;
-			}
+			case KEY_EVENT_PRESS:
+				gKeyBeingHeld = false;
+				ProcessKey(Event.key, true, false);
+				break;
+
+			case KEY_EVENT_LONG:
+			case KEY_EVENT_REPEAT:
+				gKeyBeingHeld = true;
+				ProcessKey(Event.key, true, true);  // key held event
+				break;
+
+			case KEY_EVENT_RELEASE:
+				ProcessKey(Event.key, false, Event.held);
+				gKeyBeingHeld = false;
+				break;
 		}
-		else // process new key pressed
-		{
-			gKeyReading1 = Key;
-			ProcessKey(Key, true, false);
-		}
-
-		gKeyBeingHeld = false;
-		return;
-	}
-
-	if (gDebounceCounter < key_repeat_delay_10ms || Key == KEY_INVALID) // the button is not held long enough for repeat yet, or not really pressed
-		return;
-
-	if (gDebounceCounter == key_repeat_delay_10ms) //initial key repeat with longer delay
-	{
-		if (Key != KEY_PTT)
-		{
-			gKeyBeingHeld = true;
-			ProcessKey(Key, true, true); // key held event
-		}
-	}
-	else //subsequent fast key repeats
-	{
-		if (Key == KEY_UP || Key == KEY_DOWN) // fast key repeats for up/down buttons
-		{
-			gKeyBeingHeld = true;
-			if ((gDebounceCounter % key_repeat_10ms) == 0)
-				ProcessKey(Key, true, true); // key held event
-		}
-
-		if (gDebounceCounter < 0xFFFF)
-			return;
-
-		gDebounceCounter = key_repeat_delay_10ms+1;
 	}
 }
 
@@ -1097,11 +1113,12 @@ void APP_TimeSlice10ms(void)
 #endif
 
 #ifdef ENABLE_AM_FIX
-	if (gRxVfo->Modulation == MODULATION_AM) {
-		AM_fix_10ms(gEeprom.RX_VFO);
-	}
+	AM_fix_10ms(gEeprom.RX_VFO, gRxVfo->Modulation);
 #endif
 
+	AUDIO_SeqTimeSlice10ms();
+	BATTERY_TimeSlice10ms();
+
 #ifdef ENABLE_UART
 	if (UART_IsCommandAvailable()) {
 		__disable_irq();
@@ -1113,8 +1130,14 @@ void APP_TimeSlice10ms(void)
 	if (gReducedService)
 		return;
 
-	if (gCurrentFunction != FUNCTION_POWER_SAVE || !gRxIdleMode)
+	if (gCurrentFunction != FUNCTION_POWER_SAVE || !gRxIdleMode) {
 		CheckRadioInterrupts();
+#ifdef ENABLE_SW_VOX
+		CheckVox();
+#endif
+	}
+
+	TAIL_TimeSlice10ms();
 
 	if (gCurrentFunction == FUNCTION_TRANSMIT)
 	{	// transmitting
@@ -1173,8 +1196,7 @@ void APP_TimeSlice10ms(void)
 				if (gAlarmState == ALARM_STATE_TXALARM) {
 					gAlarmState = ALARM_STATE_SITE_ALARM;
 
-					if(gEeprom.TAIL_TONE_ELIMINATION)
-						RADIO_SendCssTail();
+					TAIL_SendTx();
 					BK4819_SetupPowerAmplifier(0, 0);
 					BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
 					BK4819_Enable_AfDac_DiscMode_TxDsp();
@@ -1199,16 +1221,6 @@ void APP_TimeSlice10ms(void)
 			}
 		}
 #endif
-		// repeater tail tone elimination
-		if (gRTTECountdown_10ms > 0) {
-			if (--gRTTECountdown_10ms == 0) {
-				//if (gCurrentFunction != FUNCTION_FOREGROUND)
-					FUNCTION_Select(FUNCTION_FOREGROUND);
-
-				gUpdateStatus  = true;
-				gUpdateDisplay = true;
-			}
-		}
 	}
 
 #ifdef ENABLE_FMRADIO
@@ -1223,12 +1235,20 @@ void APP_TimeSlice10ms(void)
 
 	SCANNER_TimeSlice10ms();
 
+#ifdef ENABLE_FSK_PACKETS
+	FSK_TimeSlice10ms();
+#endif
+
 #ifdef ENABLE_AIRCOPY
 	if (gScreenToDisplay == DISPLAY_AIRCOPY && gAircopyState == AIRCOPY_TRANSFER && gAirCopyIsSendMode == 1) {
 		if (!AIRCOPY_SendMessage()) {
 			GUI_DisplayScreen();
 		}
 	}
+
+	if (gScreenToDisplay == DISPLAY_AIRCOPY && gAirCopyIsSendMode == 0) {
+		AIRCOPY_ReceiveMessage();
+	}
 #endif
 
 	CheckKeys();
@@ -1244,6 +1264,15 @@ void cancelUserInputModes(void)
 		gUpdateDisplay        = true;
 	}
 
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	if (gNameSearchMode)
+	{	// the channel found stays
+		gNameSearchMode       = false;
+		gKeyInputCountdown    = 0;
+		gRequestDisplayScreen = DISPLAY_MAIN;
+	}
+#endif
+
 	if (gWasFKeyPressed || gKeyInputCountdown > 0 || gInputBoxIndex > 0)
 	{
 		gWasFKeyPressed     = false;
@@ -1331,10 +1360,12 @@ void APP_TimeSlice500ms(void)
 
 	if (gReducedService)
 	{
-		BOARD_ADC_GetBatteryInfo(&gBatteryCurrentVoltage, &gBatteryCurrent);
-
 		if (gBatteryCurrent > 500 || gBatteryCalibration[3] < gBatteryCurrentVoltage)
 		{
+			#ifdef ENABLE_DEFERRED_SAVES
+				EEPROM_Flush();
+			#endif
+
 			#ifdef ENABLE_OVERLAY
 				overlay_FLASH_RebootToBootloader();
 			#else
@@ -1351,14 +1382,8 @@ void APP_TimeSlice500ms(void)
 
 	if (gCurrentFunction != FUNCTION_TRANSMIT)
 	{
-
 		if ((gBatteryCheckCounter & 1) == 0)
-		{
-			BOARD_ADC_GetBatteryInfo(&gBatteryVoltages[gBatteryVoltageIndex++], &gBatteryCurrent);
-			if (gBatteryVoltageIndex > 3)
-				gBatteryVoltageIndex = 0;
 			BATTERY_GetReadings(true);
-		}
 	}
 
 	// regular display updates (once every 2 sec) - if need be
@@ -1701,6 +1726,8 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 				// transmit DTMF keys
 			}
 
+			AUDIO_SeqFinish();   // let any PTT-ID go out first
+
 			if (!bKeyPressed || bKeyHeld) {
 				if (!bKeyPressed) {
 					AUDIO_AudioPathOff();
@@ -1732,11 +1759,7 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
 		else if ((!bKeyHeld && bKeyPressed) || (gAlarmState == ALARM_STATE_TX1750 && bKeyHeld && !bKeyPressed)) {
 			ALARM_Off();
-
-			if (gEeprom.REPEATER_TAIL_TONE_ELIMINATION == 0)
-				FUNCTION_Select(FUNCTION_FOREGROUND);
-			else
-				gRTTECountdown_10ms = gEeprom.REPEATER_TAIL_TONE_ELIMINATION * 10;
+			TAIL_StartRepeaterHold();
 
 			if (Key == KEY_PTT)
 				gPttWasPressed  = true;
@@ -78,36 +78,65 @@ void DTMF_clear_RX(void)
 }
 #endif
 
+static void SeqSideTone(uint16_t on)
+{	// the user will also hear the transmitted tones
+	if (on)
+		AUDIO_AudioPathOn();
+	else
+		AUDIO_AudioPathOff();
+	gEnableSpeaker = on;
+}
+
+static void SeqEnterDTMF_TX(uint16_t bLocalLoopback)
+{
+	BK4819_EnterDTMF_TX(bLocalLoopback);
+}
+
+static void SeqExitDTMF_TX(uint16_t bKeep)
+{
+	BK4819_ExitDTMF_TX(bKeep);
+}
+
+static void SeqDTMFCode(uint16_t Code)
+{
+	BK4819_PlayDTMF(Code);
+	BK4819_ExitTxMute();
+}
+
+static void QueueDTMFString(const char *pString, bool bDelayFirst)
+{
+	for (unsigned int i = 0; pString[i]; i++) {
+		uint16_t Delay;
+		if (bDelayFirst && i == 0)
+			Delay = gEeprom.DTMF_FIRST_CODE_PERSIST_TIME;
+		else if (pString[i] == '*' || pString[i] == '#')
+			Delay = gEeprom.DTMF_HASH_CODE_PERSIST_TIME;
+		else
+			Delay = gEeprom.DTMF_CODE_PERSIST_TIME;
+
+		AUDIO_SeqAdd(SeqDTMFCode, pString[i], Delay);
+		AUDIO_SeqAdd(AUDIO_SeqTxMute, true, gEeprom.DTMF_CODE_INTERVAL_TIME);
+	}
+}
+
 void DTMF_SendEndOfTransmission(void)
 {
 	if (gCurrentVfo->DTMF_PTT_ID_TX_MODE == PTT_ID_APOLLO)
-		BK4819_PlaySingleTone(2475, 250, 28, gEeprom.DTMF_SIDE_TONE);
+		AUDIO_SeqSingleTone(2475, 250, 28, gEeprom.DTMF_SIDE_TONE, false);
 	else if ((gCurrentVfo->DTMF_PTT_ID_TX_MODE == PTT_ID_TX_DOWN || gCurrentVfo->DTMF_PTT_ID_TX_MODE == PTT_ID_BOTH)
 #ifdef ENABLE_DTMF_CALLING
 		&& gDTMF_CallState == DTMF_CALL_STATE_NONE
 #endif
 	) {	// end-of-tx
-		if (gEeprom.DTMF_SIDE_TONE) {
-			AUDIO_AudioPathOn();
-			gEnableSpeaker = true;
-			SYSTEM_DelayMs(60);
-		}
-
-		BK4819_EnterDTMF_TX(gEeprom.DTMF_SIDE_TONE);
+		if (gEeprom.DTMF_SIDE_TONE)
+			AUDIO_SeqAdd(SeqSideTone, true, 60);
 
-		BK4819_PlayDTMFString(
-				gEeprom.DTMF_DOWN_CODE,
-				0,
-				gEeprom.DTMF_FIRST_CODE_PERSIST_TIME,
-				gEeprom.DTMF_HASH_CODE_PERSIST_TIME,
-				gEeprom.DTMF_CODE_PERSIST_TIME,
-				gEeprom.DTMF_CODE_INTERVAL_TIME);
-
-		AUDIO_AudioPathOff();
-		gEnableSpeaker = false;
+		AUDIO_SeqAdd(SeqEnterDTMF_TX, gEeprom.DTMF_SIDE_TONE, 0);
+		QueueDTMFString(gEeprom.DTMF_DOWN_CODE, false);
+		AUDIO_SeqAdd(SeqSideTone, false, 0);
 	}
 
-	BK4819_ExitDTMF_TX(true);
+	AUDIO_SeqAdd(SeqExitDTMF_TX, true, 0);
 }
 
 bool DTMF_ValidateCodes(char *pCode, const unsigned int size)
@@ -479,26 +508,12 @@ void DTMF_Reply(void)
 	Delay = (gEeprom.DTMF_PRELOAD_TIME < 200) ? 200 : gEeprom.DTMF_PRELOAD_TIME;
 
 	if (gEeprom.DTMF_SIDE_TONE)
-	{	// the user will also hear the transmitted tones
-		AUDIO_AudioPathOn();
-		gEnableSpeaker = true;
-	}
-
-	SYSTEM_DelayMs(Delay);
-
-	BK4819_EnterDTMF_TX(gEeprom.DTMF_SIDE_TONE);
-
-	BK4819_PlayDTMFString(
-		pString,
-		1,
-		gEeprom.DTMF_FIRST_CODE_PERSIST_TIME,
-		gEeprom.DTMF_HASH_CODE_PERSIST_TIME,
-		gEeprom.DTMF_CODE_PERSIST_TIME,
-		gEeprom.DTMF_CODE_INTERVAL_TIME);
-
-	AUDIO_AudioPathOff();
-
-	gEnableSpeaker = false;
-
-	BK4819_ExitDTMF_TX(false);
+		AUDIO_SeqAdd(SeqSideTone, true, Delay);
+	else
+		AUDIO_SeqAdd(NULL, 0, Delay);
+
+	AUDIO_SeqAdd(SeqEnterDTMF_TX, gEeprom.DTMF_SIDE_TONE, 0);
+	QueueDTMFString(pString, true);
+	AUDIO_SeqAdd(SeqSideTone, false, 0);
+	AUDIO_SeqAdd(SeqExitDTMF_TX, false, 0);
 }
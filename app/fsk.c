@@ -0,0 +1,365 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifdef ENABLE_FSK_PACKETS
+
+#include <string.h>
+
+#include "app/fsk.h"
+#include "driver/bk4819.h"
+#include "driver/crc.h"
+#include "misc.h"
+#include "radio.h"
+
+#define FRAME_WORDS_MAX       36     // same as the stock aircopy packet
+#define HEADER_WORDS          2
+#define LEGACY_START          0xABCD
+#define LEGACY_END            0xDCBA
+
+#ifndef FSK_TX_QUEUE_LEN
+	#define FSK_TX_QUEUE_LEN  2
+#endif
+#ifndef FSK_RX_QUEUE_LEN
+	#define FSK_RX_QUEUE_LEN  2
+#endif
+
+// give up on the TX finished interrupt after this, a full frame is ~570ms
+#define TX_TIMEOUT_10ms       100
+
+enum TxState_t {
+	TX_IDLE = 0,
+	TX_KEYUP,       // PA coming up
+	TX_LOADED,      // FIFO loaded, start shortly
+	TX_ON_AIR,      // waiting for TX finished
+	TX_TAIL         // last frame done, let the modem drain
+};
+
+typedef enum TxState_t TxState_t;
+
+typedef struct {
+	uint8_t  words;
+	uint16_t data[FRAME_WORDS_MAX];
+} TxSlot_t;
+
+FSK_Stats_t        gFSK_Stats;
+
+static TxSlot_t    txQueue[FSK_TX_QUEUE_LEN];
+static uint8_t     txHead;
+static uint8_t     txCount;
+static uint8_t     txSeq;
+static TxState_t   txState;
+static uint8_t     txTimer_10ms;
+static uint8_t     txGap_10ms;
+
+static FSK_Frame_t rxQueue[FSK_RX_QUEUE_LEN];
+static uint8_t     rxHead;
+static uint8_t     rxCount;
+static uint16_t    rxWords[FRAME_WORDS_MAX];
+static uint8_t     rxIndex;
+static uint8_t     rxExpected;
+static bool        rxEnabled;
+
+static unsigned int PadWords(const unsigned int words)
+{
+	return (words + 3) & ~3u;
+}
+
+// words up to and including the CRC of a frame with 'length' payload bytes
+static unsigned int FrameWords(const unsigned int length)
+{
+	return HEADER_WORDS + ((length + 1) / 2) + 1;
+}
+
+static void StartRx(void)
+{
+	rxIndex    = 0;
+	rxExpected = 0;
+	BK4819_ToggleGpioOut(BK4819_GPIO0_PIN28_RX_ENABLE, true);
+	BK4819_PrepareFSKReceive(FRAME_WORDS_MAX);
+}
+
+static void RestartRx(void)
+{
+	rxIndex    = 0;
+	rxExpected = 0;
+	BK4819_RestartFSKReceive();
+}
+
+static void RxError(void)
+{
+	gFSK_Stats.rx_errors++;
+	RestartRx();
+}
+
+// the first 4 words are in, work out how long the frame is
+static bool ParseHeader(void)
+{
+	if (rxWords[0] == LEGACY_START) {
+		rxExpected = FRAME_WORDS_MAX;
+		return true;
+	}
+
+	const unsigned int length = rxWords[0] >> 8;
+	if (length > FSK_MAX_PAYLOAD)
+		return false;
+
+	rxExpected = PadWords(FrameWords(length));
+	return true;
+}
+
+static bool DecodeFrame(FSK_Frame_t *pFrame)
+{
+	if (rxWords[0] == LEGACY_START) {
+		if (rxWords[FRAME_WORDS_MAX - 1] != LEGACY_END)
+			return false;
+		pFrame->type   = FSK_TYPE_LEGACY;
+		pFrame->seq    = 0;
+		pFrame->length = FSK_LEGACY_PAYLOAD;
+		memcpy(pFrame->payload, &rxWords[1], FSK_LEGACY_PAYLOAD);
+		return true;
+	}
+
+	const unsigned int length = rxWords[0] >> 8;
+	const unsigned int crc    = FrameWords(length) - 1;
+	if (rxWords[crc] != CRC_Calculate(rxWords, crc * 2))
+		return false;
+
+	pFrame->type   = rxWords[0] & 0xFF;
+	pFrame->seq    = rxWords[1] >> 8;
+	pFrame->length = length;
+	memcpy(pFrame->payload, &rxWords[HEADER_WORDS], length);
+
+	return pFrame->type != FSK_TYPE_LEGACY;
+}
+
+// returns true if RX got restarted
+static bool ReadFifo(void)
+{
+	for (unsigned int i = 0; i < 4 && rxIndex < FRAME_WORDS_MAX; i++)
+		rxWords[rxIndex++] = BK4819_ReadRegister(BK4819_REG_5F);
+
+	if (rxExpected == 0 && !ParseHeader()) {
+		RxError();
+		return true;
+	}
+
+	if (rxIndex < rxExpected)
+		return false;
+
+	if (rxCount >= FSK_RX_QUEUE_LEN) {
+		gFSK_Stats.rx_dropped++;
+		RestartRx();
+		return true;
+	}
+
+	FSK_Frame_t *pFrame = &rxQueue[(rxHead + rxCount) % FSK_RX_QUEUE_LEN];
+	if (!DecodeFrame(pFrame)) {
+		RxError();
+		return true;
+	}
+
+	rxCount++;
+	gFSK_Stats.rx_frames++;
+	RestartRx();
+	return true;
+}
+
+static void TxFinished(void)
+{
+	txHead = (txHead + 1) % FSK_TX_QUEUE_LEN;
+	txCount--;
+	gFSK_Stats.tx_frames++;
+
+	if (txCount > 0) {
+		// keep the PA up and send the next one straight away
+		BK4819_LoadFSKTxData(txQueue[txHead].data, txQueue[txHead].words);
+		txState      = TX_LOADED;
+		txTimer_10ms = 2 + txGap_10ms;
+		return;
+	}
+
+	txState      = TX_TAIL;
+	txTimer_10ms = 2;
+}
+
+static void TxOff(void)
+{
+	BK4819_SetupPowerAmplifier(0, 0);
+	BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
+
+	txState = TX_IDLE;
+
+	if (rxEnabled)
+		StartRx();
+	else
+		BK4819_ResetFSK();
+}
+
+void FSK_Init(void)
+{
+	txHead     = 0;
+	txCount    = 0;
+	txState    = TX_IDLE;
+	txGap_10ms = 0;
+	rxHead     = 0;
+	rxCount    = 0;
+	rxIndex    = 0;
+	rxEnabled  = false;
+	memset(&gFSK_Stats, 0, sizeof(gFSK_Stats));
+
+	BK4819_SetupFSK();
+	BK4819_ResetFSK();
+}
+
+void FSK_StartRx(void)
+{
+	rxEnabled = true;
+	if (txState == TX_IDLE)
+		StartRx();
+}
+
+void FSK_StopRx(void)
+{
+	rxEnabled = false;
+	if (txState == TX_IDLE)
+		BK4819_ResetFSK();
+}
+
+bool FSK_Send(FSK_Type_t type, const void *pPayload, uint8_t length)
+{
+	if (txCount >= FSK_TX_QUEUE_LEN)
+		return false;
+
+	TxSlot_t *pSlot = &txQueue[(txHead + txCount) % FSK_TX_QUEUE_LEN];
+	uint16_t *pData = pSlot->data;
+
+	memset(pData, 0, sizeof(pSlot->data));
+
+	if (type == FSK_TYPE_LEGACY) {
+		if (length != FSK_LEGACY_PAYLOAD)
+			return false;
+		pData[0] = LEGACY_START;
+		memcpy(&pData[1], pPayload, FSK_LEGACY_PAYLOAD);
+		pData[FRAME_WORDS_MAX - 1] = LEGACY_END;
+		pSlot->words = FRAME_WORDS_MAX;
+	}
+	else {
+		if (length > FSK_MAX_PAYLOAD)
+			return false;
+		const unsigned int crc = FrameWords(length) - 1;
+		pData[0] = (length << 8) | type;
+		pData[1] = txSeq++ << 8;
+		memcpy(&pData[HEADER_WORDS], pPayload, length);
+		pData[crc] = CRC_Calculate(pData, crc * 2);
+		pSlot->words = PadWords(crc + 1);
+	}
+
+	txCount++;
+	return true;
+}
+
+bool FSK_TxBusy(void)
+{
+	return txState != TX_IDLE || txCount > 0;
+}
+
+void FSK_SetTxGap(uint8_t gap_10ms)
+{
+	txGap_10ms = gap_10ms;
+}
+
+bool FSK_Receive(FSK_Frame_t *pFrame)
+{
+	if (rxCount == 0)
+		return false;
+
+	*pFrame = rxQueue[rxHead];
+	rxHead = (rxHead + 1) % FSK_RX_QUEUE_LEN;
+	rxCount--;
+	return true;
+}
+
+void FSK_HandleInterrupt(uint16_t status)
+{
+	if (txState == TX_ON_AIR && (status & BK4819_REG_02_FSK_TX_FINISHED)) {
+		TxFinished();
+		return;
+	}
+
+	if (!rxEnabled || txState != TX_IDLE)
+		return;
+
+	bool restarted = false;
+
+	if (status & BK4819_REG_02_FSK_FIFO_ALMOST_FULL)
+		restarted = ReadFifo();
+
+	if ((status & BK4819_REG_02_FSK_RX_FINISHED) && !restarted) {
+		// ran out of the set packet length half way through a frame
+		if (rxIndex > 0)
+			RxError();
+		else
+			RestartRx();
+	}
+}
+
+void FSK_TimeSlice10ms(void)
+{
+	switch (txState) {
+		case TX_IDLE:
+			if (txCount == 0)
+				break;
+			RADIO_SetTxParameters();
+			txState      = TX_KEYUP;
+			txTimer_10ms = 2;
+			break;
+
+		case TX_KEYUP:
+			if (--txTimer_10ms > 0)
+				break;
+			BK4819_LoadFSKTxData(txQueue[txHead].data, txQueue[txHead].words);
+			txState      = TX_LOADED;
+			txTimer_10ms = 2;
+			break;
+
+		case TX_LOADED:
+			if (--txTimer_10ms > 0)
+				break;
+			BK4819_StartFSKTransmit();
+			txState      = TX_ON_AIR;
+			txTimer_10ms = TX_TIMEOUT_10ms;
+			break;
+
+		case TX_ON_AIR:
+			if (--txTimer_10ms == 0)
+				TxFinished();   // never saw the interrupt
+			break;
+
+		case TX_TAIL:
+			if (txCount > 0) {
+				// another one came in while the PA was still up
+				BK4819_LoadFSKTxData(txQueue[txHead].data, txQueue[txHead].words);
+				txState      = TX_LOADED;
+				txTimer_10ms = 2 + txGap_10ms;
+				break;
+			}
+			if (--txTimer_10ms == 0)
+				TxOff();
+			break;
+	}
+}
+
+#endif
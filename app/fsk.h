@@ -0,0 +1,91 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_FSK_H
+#define APP_FSK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// FSK packet layer (1200 baud, BK4819 FSK modem)
+//
+// variable length frames with a sequence number and a CRC, sent and
+// received through small queues so nothing blocks the main loop. The
+// on-air frame is
+//
+//   [length << 8 | type] [seq << 8 | 0] [payload words ..] [CRC] [0 padding]
+//
+// padded to a multiple of 4 words, which is what the modem hands over per
+// FIFO almost full interrupt. The CRC is CRC_Calculate() over the header
+// and the payload.
+//
+// FSK_TYPE_LEGACY frames are the stock aircopy packet instead,
+// [0xABCD] [34 words] [0xDCBA] without any header or CRC of ours, so radios
+// running the original firmware can talk to us.
+
+#define FSK_MAX_PAYLOAD    66    // bytes, keeps a frame within 36 words
+#define FSK_LEGACY_PAYLOAD 68    // bytes, words 1 to 34 of the stock packet
+
+// frame types, anything not listed here is free for new users
+enum FSK_Type_t {
+	FSK_TYPE_MESSAGE     = 1,
+	FSK_TYPE_BEACON      = 2,
+	FSK_TYPE_AIRCOPY_MAP = 3,     // aircopy receiver's bitmap of the blocks it has
+	FSK_TYPE_LEGACY      = 0xFF   // FSK_LEGACY_PAYLOAD bytes, stock aircopy packet
+};
+
+typedef enum FSK_Type_t FSK_Type_t;
+
+typedef struct {
+	uint8_t  type;
+	uint8_t  seq;
+	uint8_t  length;
+	uint8_t  payload[FSK_LEGACY_PAYLOAD] __attribute__((aligned(2)));
+} FSK_Frame_t;
+
+typedef struct {
+	uint16_t tx_frames;
+	uint16_t rx_frames;
+	uint16_t rx_errors;     // broken or unknown frames
+	uint16_t rx_dropped;    // good frames lost to a full RX queue
+} FSK_Stats_t;
+
+extern FSK_Stats_t gFSK_Stats;
+
+// set up the modem, RX and TX are off afterwards
+void FSK_Init(void);
+
+// listen for frames, also re-armed after every transmission until
+// FSK_StopRx() is called
+void FSK_StartRx(void);
+void FSK_StopRx(void);
+
+// queue a frame, the layer keys up the PA and sends it (and anything
+// queued after it) in one go. false if the queue is full
+bool FSK_Send(FSK_Type_t type, const void *pPayload, uint8_t length);
+// true while frames are queued or on air
+bool FSK_TxBusy(void);
+// extra wait between back to back frames, for slow receivers
+void FSK_SetTxGap(uint8_t gap_10ms);
+
+// oldest received frame, false if there's none
+bool FSK_Receive(FSK_Frame_t *pFrame);
+
+// BK4819 REG_02 interrupt status, from CheckRadioInterrupts()
+void FSK_HandleInterrupt(uint16_t status);
+void FSK_TimeSlice10ms(void);
+
+#endif
@@ -34,6 +34,7 @@
 #include "functions.h"
 #include "misc.h"
 #include "settings.h"
+#include "tail.h"
 #include "ui/inputbox.h"
 #include "ui/ui.h"
 
@@ -109,11 +110,7 @@ void GENERIC_Key_PTT(bool bKeyPressed)
 			}
 			else {
 				APP_EndTransmission();
-
-				if (gEeprom.REPEATER_TAIL_TONE_ELIMINATION == 0)
-					FUNCTION_Select(FUNCTION_FOREGROUND);
-				else
-					gRTTECountdown_10ms = gEeprom.REPEATER_TAIL_TONE_ELIMINATION * 10;
+				TAIL_StartRepeaterHold();
 			}
 
 			gFlagEndTransmission = false;
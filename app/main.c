@@ -43,6 +43,12 @@
 #include "ui/ui.h"
 #include <stdlib.h>
 
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	bool    gNameSearchMode;
+	uint8_t gNameSearchKeys[NAMEIDX_KEYS];
+	uint8_t gNameSearchCount;
+#endif
+
 void toggle_chan_scanlist(void)
 {	// toggle the selected channels scanlist setting
 
@@ -681,6 +687,120 @@ static void MAIN_Key_UP_DOWN(bool bKeyPressed, bool bKeyHeld, int8_t Direction)
 	gPttWasReleased = true;
 }
 
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+void MAIN_ToggleNameSearch(void)
+{
+	gRequestDisplayScreen = DISPLAY_MAIN;
+
+	if (gNameSearchMode) {
+		gNameSearchMode    = false;
+		gKeyInputCountdown = 0;
+		return;
+	}
+
+	if (!IS_MR_CHANNEL(gEeprom.ScreenChannel[gEeprom.TX_VFO]) || gScanStateDir != SCAN_OFF || gDTMF_InputMode) {
+		gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+		return;
+	}
+
+	gInputBoxIndex     = 0;
+	gNameSearchMode    = true;
+	gNameSearchCount   = 0;
+	gKeyInputCountdown = key_input_timeout_500ms;
+}
+
+static void SelectChannel(const uint8_t Channel)
+{
+	const uint8_t Vfo = gEeprom.TX_VFO;
+
+	if (Channel == gEeprom.ScreenChannel[Vfo])
+		return;
+
+	gEeprom.MrChannel[Vfo]     = Channel;
+	gEeprom.ScreenChannel[Vfo] = Channel;
+	gRequestSaveVFO            = true;
+	gVfoConfigureMode          = VFO_CONFIGURE_RELOAD;
+}
+
+// true if the search has used the key
+static bool NameSearchKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
+{
+	const uint8_t channel = gEeprom.ScreenChannel[gEeprom.TX_VFO];
+	uint8_t       next;
+
+	switch (Key) {
+		case KEY_0...KEY_9:
+			if (!bKeyPressed || bKeyHeld)
+				return true;
+
+			// this channel if it still fits, otherwise the next one that does
+			if (gNameSearchCount < NAMEIDX_KEYS) {
+				gNameSearchKeys[gNameSearchCount] = Key - KEY_0;
+				next = NAMEIDX_Find(gNameSearchKeys, gNameSearchCount + 1, channel, 1);
+				if (next != 0xFF) {
+					gNameSearchCount++;
+					SelectChannel(next);
+					gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+					break;
+				}
+			}
+
+			gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+			break;
+
+		case KEY_UP:
+		case KEY_DOWN:
+			if (gNameSearchCount == 0)
+				return false;   // nothing typed yet, the usual channel step
+			if (!bKeyPressed)
+				return true;
+
+			{
+				const int8_t  direction = (Key == KEY_UP) ? 1 : -1;
+				const uint8_t from      = (direction > 0) ? ((channel == MR_CHANNEL_LAST) ? 0 : channel + 1) :
+				                                            ((channel == 0) ? MR_CHANNEL_LAST : channel - 1);
+
+				next = NAMEIDX_Find(gNameSearchKeys, gNameSearchCount, from, direction);
+				if (next != 0xFF)
+					SelectChannel(next);
+				if (!bKeyHeld)
+					gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+			}
+			break;
+
+		case KEY_EXIT:
+			if (!bKeyPressed || bKeyHeld)
+				return true;
+
+			if (gNameSearchCount > 0)
+				gNameSearchCount--;
+			else
+				gNameSearchMode = false;
+			gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+			break;
+
+		case KEY_MENU:
+			// done, the channel's already selected. On the release, or
+			// it would open the menu
+			if (bKeyPressed && !bKeyHeld)
+				gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+			else
+				gNameSearchMode = false;
+			break;
+
+		default:
+			gNameSearchMode       = false;
+			gKeyInputCountdown    = 0;
+			gRequestDisplayScreen = DISPLAY_MAIN;
+			return false;
+	}
+
+	gKeyInputCountdown    = gNameSearchMode ? key_input_timeout_500ms : 0;
+	gRequestDisplayScreen = DISPLAY_MAIN;
+	return true;
+}
+#endif
+
 void MAIN_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 {
 #ifdef ENABLE_FMRADIO
@@ -691,6 +811,11 @@ void MAIN_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 	}
 #endif
 
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	if (gNameSearchMode && NameSearchKey(Key, bKeyPressed, bKeyHeld))
+		return;
+#endif
+
 	if (gDTMF_InputMode && bKeyPressed && !bKeyHeld) {
 		const char Character = DTMF_GetCharacter(Key);
 		if (Character != 0xFF)
@@ -18,8 +18,23 @@
 #define APP_MAIN_H
 
 #include "driver/keyboard.h"
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	#include "name_index.h"
+#endif
 
 void MAIN_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	// jump to a memory channel by typing its name, a key a letter (T9 without
+	// the multiple presses). Each key goes straight to the first channel from
+	// here on that still fits, UP/DOWN go through the others that do, EXIT
+	// takes a key back, MENU's done
+	extern bool    gNameSearchMode;
+	extern uint8_t gNameSearchKeys[NAMEIDX_KEYS];
+	extern uint8_t gNameSearchCount;
+
+	void MAIN_ToggleNameSearch(void);
+#endif
+
 #endif
 
@@ -25,6 +25,9 @@
 #include "app/scanner.h"
 #include "audio.h"
 #include "board.h"
+#ifdef ENABLE_CHANNEL_BANKS
+	#include "channel_bank.h"
+#endif
 #include "bsp/dp32g030/gpio.h"
 #include "driver/backlight.h"
 #include "driver/bk4819.h"
@@ -33,8 +36,11 @@
 #include "driver/keyboard.h"
 #include "frequencies.h"
 #include "helper/battery.h"
+#include "helper/battery_model.h"
+#include "key_queue.h"
 #include "misc.h"
 #include "settings.h"
+#include "tail.h"
 #if defined(ENABLE_OVERLAY)
 	#include "sram-overlay.h"
 #endif
@@ -275,6 +281,16 @@ int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
 			*pMax = 10;
 			break;
 
+		case MENU_STE_MODE:
+			*pMin = 0;
+			*pMax = ARRAY_SIZE(gSubMenu_STE_MODE) - 1;
+			break;
+
+		case MENU_STE_TIME:
+			*pMin = 1;
+			*pMax = TAIL_TIME_MAX;
+			break;
+
 		case MENU_MEM_CH:
 		case MENU_1_CALL:
 		case MENU_DEL_CH:
@@ -331,6 +347,23 @@ int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
 			*pMax = 99;
 			break;
 
+		case MENU_KEY_LONG:
+			*pMin = 3;    // 100ms units
+			*pMax = 15;
+			break;
+
+#ifdef ENABLE_CHANNEL_BANKS
+		case MENU_CH_BANK:
+			*pMin = 0;
+			*pMax = CHBANK_COUNT - 1;
+			break;
+#endif
+
+		case MENU_KEY_RPT:
+			*pMin = 4;    // 10ms units
+			*pMax = 25;
+			break;
+
 #ifdef ENABLE_DTMF_CALLING
 		case MENU_D_LIST:
 			*pMin = 1;
@@ -595,6 +628,16 @@ void MENU_AcceptSetting(void)
 			gEeprom.REPEATER_TAIL_TONE_ELIMINATION = gSubMenuSelection;
 			break;
 
+		case MENU_STE_MODE:
+			gTxVfo->TAIL_MODE   = gSubMenuSelection;
+			gRequestSaveChannel = 1;
+			return;
+
+		case MENU_STE_TIME:
+			gTxVfo->TAIL_TIME   = gSubMenuSelection;
+			gRequestSaveChannel = 1;
+			return;
+
 		case MENU_MIC:
 			gEeprom.MIC_SENSITIVITY = gSubMenuSelection;
 			SETTINGS_LoadCalibration();
@@ -646,6 +689,25 @@ void MENU_AcceptSetting(void)
 			gEeprom.DTMF_PRELOAD_TIME = gSubMenuSelection * 10;
 			break;
 
+		case MENU_KEY_LONG:
+			gKeyTiming.long_press_10ms = gSubMenuSelection * 10;
+			break;
+
+#ifdef ENABLE_CHANNEL_BANKS
+		case MENU_CH_BANK:
+			if (!CHBANK_Select(gSubMenuSelection)) {
+				gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;   // too many channels for their bank
+				return;
+			}
+			gVfoConfigureMode = VFO_CONFIGURE_RELOAD;
+			gFlagResetVfos    = true;
+			return;
+#endif
+
+		case MENU_KEY_RPT:
+			gKeyTiming.repeat_10ms = gSubMenuSelection;
+			break;
+
 		case MENU_PTT_ID:
 			gTxVfo->DTMF_PTT_ID_TX_MODE = gSubMenuSelection;
 			gRequestSaveChannel         = 1;
@@ -779,6 +841,9 @@ void MENU_AcceptSetting(void)
 
 		case MENU_BATTYP:
 			gEeprom.BATTERY_TYPE = gSubMenuSelection;
+			#ifdef ENABLE_BATTERY_MODEL
+				BATMODEL_Init();
+			#endif
 			break;
 
 		case MENU_F1SHRT:
@@ -992,6 +1057,14 @@ void MENU_ShowCurrentSetting(void)
 			gSubMenuSelection = gEeprom.REPEATER_TAIL_TONE_ELIMINATION;
 			break;
 
+		case MENU_STE_MODE:
+			gSubMenuSelection = gTxVfo->TAIL_MODE;
+			break;
+
+		case MENU_STE_TIME:
+			gSubMenuSelection = gTxVfo->TAIL_TIME;
+			break;
+
 		case MENU_MIC:
 			gSubMenuSelection = gEeprom.MIC_SENSITIVITY;
 			break;
@@ -1045,6 +1118,22 @@ void MENU_ShowCurrentSetting(void)
 			gSubMenuSelection = gEeprom.DTMF_PRELOAD_TIME / 10;
 			break;
 
+		case MENU_KEY_LONG:
+			gSubMenuSelection = gKeyTiming.long_press_10ms / 10;
+			break;
+
+#ifdef ENABLE_CHANNEL_BANKS
+		case MENU_CH_BANK: {
+			const uint8_t bank = CHBANK_GetCurrent();
+			gSubMenuSelection = (bank < CHBANK_COUNT) ? bank : 0;
+			break;
+		}
+#endif
+
+		case MENU_KEY_RPT:
+			gSubMenuSelection = gKeyTiming.repeat_10ms;
+			break;
+
 		case MENU_PTT_ID:
 			gSubMenuSelection = gTxVfo->DTMF_PTT_ID_TX_MODE;
 			break;
@@ -1484,6 +1573,10 @@ static void MENU_Key_MENU(const bool bKeyPressed, const bool bKeyHeld)
 
 						MENU_AcceptSetting();
 
+						#ifdef ENABLE_DEFERRED_SAVES
+							EEPROM_Flush();
+						#endif
+
 						#if defined(ENABLE_OVERLAY)
 							overlay_FLASH_RebootToBootloader();
 						#else
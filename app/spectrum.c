@@ -113,7 +113,7 @@ static uint8_t DBm2S(int dbm) {
 }
 
 static int Rssi2DBm(uint16_t rssi) {
-  return (rssi / 2) - 160 + dBmCorrTable[gRxVfo->Band];
+  return (rssi / 2) - 160;
 }
 
 static uint16_t GetRegMenuValue(uint8_t st) {
@@ -123,7 +123,7 @@ static uint16_t GetRegMenuValue(uint8_t st) {
 
 void LockAGC()
 {
-  RADIO_SetupAGC(settings.modulationType==MODULATION_AM, lockAGC);
+  RADIO_SetupAGC(settings.modulationType, lockAGC);
   lockAGC = true;
 }
 
@@ -317,12 +317,8 @@ uint16_t GetRssi() {
   while ((BK4819_ReadRegister(0x63) & 0b11111111) >= 255) {
     SYSTICK_DelayUs(100);
   }
-  uint16_t rssi = BK4819_GetRSSI();
-#ifdef ENABLE_AM_FIX
-  if(settings.modulationType==MODULATION_AM && gSetting_AM_fix)
-    rssi += AM_fix_get_gain_diff()*2;
-#endif
-  return rssi;
+  // a fresh reading for every step, the per tick cached one is no use here
+  return RADIO_CompensateRssi(BK4819_GetRSSI(), settings.modulationType, gRxVfo->Band);
 }
 
 static void ToggleAudio(bool on) {
@@ -340,7 +336,7 @@ static void ToggleAudio(bool on) {
 static void ToggleRX(bool on) {
   isListening = on;
 
-  RADIO_SetupAGC(on, lockAGC);
+  RADIO_SetupAGC(on ? settings.modulationType : MODULATION_UKNOWN, lockAGC);
   BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, on);
 
   ToggleAudio(on);
@@ -451,7 +447,7 @@ static void Measure()
 // Update things by keypress
 
 static uint16_t dbm2rssi(int dBm) {
-  return (dBm + 160 - dBmCorrTable[gRxVfo->Band]) * 2;
+  return (dBm + 160) * 2;
 }
 
 static void ClampRssiTriggerLevel() {
@@ -699,12 +695,7 @@ static void DrawStatus() {
 #endif
   GUI_DisplaySmallest(String, 0, 1, true, true);
 
-  BOARD_ADC_GetBatteryInfo(&gBatteryVoltages[gBatteryCheckCounter++ % 4],
-                           &gBatteryCurrent);
-
-  uint16_t voltage = (gBatteryVoltages[0] + gBatteryVoltages[1] +
-                      gBatteryVoltages[2] + gBatteryVoltages[3]) /
-                     4 * 760 / gBatteryCalibration[3];
+  uint16_t voltage = BATTERY_GetVoltage();
 
   unsigned perc = BATTERY_VoltsToPercent(voltage);
 
@@ -1209,14 +1200,15 @@ static void UpdateListening() {
 }
 
 static void Tick() {
-#ifdef ENABLE_AM_FIX
   if (gNextTimeslice) {
     gNextTimeslice = false;
-    if(settings.modulationType == MODULATION_AM && !lockAGC) {
-      AM_fix_10ms(vfo); //allow AM_Fix to apply its AGC action
+    BATTERY_TimeSlice10ms();
+#ifdef ENABLE_AM_FIX
+    if(!lockAGC) {
+      AM_fix_10ms(vfo, settings.modulationType); //allow AM_Fix to apply its AGC action
     }
-  }
 #endif
+  }
 
 #ifdef ENABLE_SCAN_RANGES
   if (gNextTimeslice_500ms) {
@@ -0,0 +1,322 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/tone_decoder.h"
+#include "misc.h"
+
+// minimum RMS level of a block to look at it at all (on the +/-2047 scale)
+#ifndef TONE_DECODER_MIN_RMS
+	#define TONE_DECODER_MIN_RMS   16
+#endif
+
+// Goertzel coefficients, 2 * cos(2 * pi * f / 8000) in Q10
+
+static const int16_t dtmf_coef[8] = {
+	1749,   //  697 Hz
+	1685,   //  770 Hz
+	1606,   //  852 Hz
+	1514,   //  941 Hz
+	1192,   // 1209 Hz
+	1020,   // 1336 Hz
+	 818,   // 1477 Hz
+	 582    // 1633 Hz
+};
+
+// digits 0-9, then the repeat tone
+static const int16_t zvei1_coef[11] = {
+	-633,   // 2400 Hz
+	1378,   // 1060 Hz
+	1255,   // 1160 Hz
+	1111,   // 1270 Hz
+	 930,   // 1400 Hz
+	 739,   // 1530 Hz
+	 525,   // 1670 Hz
+	 273,   // 1830 Hz
+	   0,   // 2000 Hz
+	-320,   // 2200 Hz
+	-930    // 2600 Hz
+};
+
+static const int16_t ccir_coef[11] = {
+	  31,   // 1981 Hz
+	1300,   // 1124 Hz
+	1208,   // 1197 Hz
+	1104,   // 1275 Hz
+	 989,   // 1358 Hz
+	 863,   // 1446 Hz
+	 724,   // 1540 Hz
+	 571,   // 1640 Hz
+	 404,   // 1747 Hz
+	 225,   // 1860 Hz
+	-177    // 2110 Hz
+};
+
+// 1750Hz and either side of it, so a burst up to ~2% off still lands in one
+static const int16_t tone1750_coef[3] = {
+	 440,   // 1724 Hz
+	 400,   // 1750 Hz
+	 358    // 1776 Hz
+};
+
+static const char dtmf_symbols[16] = "123A456B789C*0#D";
+
+enum {
+	FILTER_DTMF    = 0,
+	FILTER_SELCALL = FILTER_DTMF + ARRAY_SIZE(dtmf_coef),
+	FILTER_1750    = FILTER_SELCALL + ARRAY_SIZE(zvei1_coef),
+	FILTER_N_ELEM  = FILTER_1750 + ARRAY_SIZE(tone1750_coef)
+};
+
+typedef struct {
+	int32_t s1;
+	int32_t s2;
+} goertzel_t;
+
+// turns per block decisions into symbols, a symbol has to be seen for
+// 'blocks_on' blocks in a row and is not repeated until the detector
+// saw nothing for 'blocks_off' blocks or another symbol came along
+typedef struct {
+	char    candidate;
+	char    emitted;
+	uint8_t count;
+} validator_t;
+
+static uint8_t        modes;
+static int16_t        coef[FILTER_N_ELEM];
+static goertzel_t     filter[FILTER_N_ELEM];
+static int32_t        dc_acc;
+static uint32_t       energy;
+static uint8_t        sample_count;
+
+static validator_t    dtmf_validator;
+static validator_t    selcall_validator;
+static validator_t    tone1750_validator;
+static char           selcall_last_digit;
+
+static volatile bool    has_input;
+static volatile char    symbol_buf[16];
+static volatile uint8_t symbol_mode[16];
+static volatile uint8_t symbol_wr;
+static volatile uint8_t symbol_rd;
+
+static void PutSymbol(const char symbol, const TONE_DECODER_Mode_t mode)
+{
+	const uint8_t next = (symbol_wr + 1) % ARRAY_SIZE(symbol_buf);
+	if (next == symbol_rd)
+		return;	// full, drop it
+	symbol_buf[symbol_wr]  = symbol;
+	symbol_mode[symbol_wr] = mode;
+	symbol_wr = next;
+}
+
+static bool Validate(validator_t *v, const char symbol, const uint8_t blocks_on, const uint8_t blocks_off)
+{
+	if (symbol != v->candidate) {
+		v->candidate = symbol;
+		v->count     = 0;
+	}
+
+	if (v->count < 255)
+		v->count++;
+
+	if (symbol == 0) {
+		if (v->count >= blocks_off)
+			v->emitted = 0;
+		return false;
+	}
+
+	if (v->count < blocks_on || symbol == v->emitted)
+		return false;
+
+	v->emitted = symbol;
+	return true;
+}
+
+// power of filter 'i', scaled so that a lone sine wave right on the
+// filter frequency gives about the same figure as the block energy
+static uint32_t GetPower(const unsigned i)
+{
+	const int32_t s1 = filter[i].s1 >> 5;
+	const int32_t s2 = filter[i].s2 >> 5;
+	const int32_t p  = s1 * s1 + s2 * s2 - ((s1 * coef[i]) >> 10) * s2;
+	return (p > 0) ? p : 0;
+}
+
+// index of the strongest of 'count' powers, the runner up goes to 'second'
+static unsigned FindPeak(const uint32_t *power, const unsigned count, uint32_t *second)
+{
+	unsigned best = 0;
+	*second = 0;
+	for (unsigned i = 1; i < count; i++) {
+		if (power[i] > power[best]) {
+			*second = power[best];
+			best    = i;
+		}
+		else if (power[i] > *second)
+			*second = power[i];
+	}
+	return best;
+}
+
+static char DetectDTMF(const uint32_t *power, const uint32_t level)
+{
+	uint32_t row_second;
+	uint32_t col_second;
+	const unsigned row = FindPeak(&power[0], 4, &row_second);
+	const unsigned col = FindPeak(&power[4], 4, &col_second);
+	const uint32_t row_power = power[row];
+	const uint32_t col_power = power[4 + col];
+
+	if (row_power * 8 < level || col_power * 8 < level)
+		return 0;   // each tone needs 1/8 of the block energy ..
+	if ((row_power + col_power) * 3 < level)
+		return 0;   // .. and both together a third of it
+	if (row_power > col_power * 6 || col_power > row_power * 6)
+		return 0;   // more than ~8dB twist
+	if (row_second * 4 > row_power || col_second * 4 > col_power)
+		return 0;   // not clean
+
+	return dtmf_symbols[row * 4 + col];
+}
+
+static char DetectSelcall(const uint32_t *power, const uint32_t level)
+{
+	uint32_t second;
+	const unsigned best = FindPeak(power, ARRAY_SIZE(zvei1_coef), &second);
+
+	if (power[best] * 5 < level * 2 || second * 4 > power[best])
+		return 0;
+
+	return (best < 10) ? '0' + best : 'E';
+}
+
+static void ProcessBlock(void)
+{
+	uint32_t power[FILTER_N_ELEM];
+	for (unsigned i = 0; i < FILTER_N_ELEM; i++)
+		power[i] = GetPower(i);
+
+	// what a lone sine wave would give in GetPower()
+	const uint32_t level = ((energy >> 6) * TONE_DECODER_BLOCK_SIZE) >> 5;
+	const bool     loud  = energy >= (uint32_t)TONE_DECODER_BLOCK_SIZE * TONE_DECODER_MIN_RMS * TONE_DECODER_MIN_RMS;
+
+	char dtmf = 0;
+	if (modes & TONE_DECODER_DTMF) {
+		if (loud)
+			dtmf = DetectDTMF(&power[FILTER_DTMF], level);
+		if (Validate(&dtmf_validator, dtmf, 2, 1))
+			PutSymbol(dtmf, TONE_DECODER_DTMF);
+	}
+
+	if (modes & (TONE_DECODER_ZVEI1 | TONE_DECODER_CCIR)) {
+		char digit = 0;
+		if (loud && dtmf == 0)
+			digit = DetectSelcall(&power[FILTER_SELCALL], level);
+		if (Validate(&selcall_validator, digit, 2, 2)) {
+			if (digit == 'E')
+				digit = selcall_last_digit;
+			if (digit != 0)
+				PutSymbol(digit, modes & TONE_DECODER_ZVEI1 ? TONE_DECODER_ZVEI1 : TONE_DECODER_CCIR);
+			selcall_last_digit = digit;
+		}
+	}
+
+	if (modes & TONE_DECODER_1750) {
+		uint32_t       second;
+		const unsigned best = FindPeak(&power[FILTER_1750], ARRAY_SIZE(tone1750_coef), &second);
+		const bool     tone = loud && power[FILTER_1750 + best] * 5 >= level * 2;
+		if (Validate(&tone1750_validator, tone ? TONE_DECODER_SYMBOL_1750 : 0, 10, 2))
+			PutSymbol(TONE_DECODER_SYMBOL_1750, TONE_DECODER_1750);
+	}
+}
+
+void TONE_DECODER_Init(uint8_t new_modes)
+{
+	modes = 0;  // keep PushSample() out while we set up
+
+	memset(coef, 0, sizeof(coef));
+	memcpy(&coef[FILTER_DTMF], dtmf_coef, sizeof(dtmf_coef));
+	if (new_modes & TONE_DECODER_ZVEI1)
+		memcpy(&coef[FILTER_SELCALL], zvei1_coef, sizeof(zvei1_coef));
+	else if (new_modes & TONE_DECODER_CCIR)
+		memcpy(&coef[FILTER_SELCALL], ccir_coef, sizeof(ccir_coef));
+	memcpy(&coef[FILTER_1750], tone1750_coef, sizeof(tone1750_coef));
+
+	memset(filter, 0, sizeof(filter));
+	memset(&dtmf_validator, 0, sizeof(dtmf_validator));
+	memset(&selcall_validator, 0, sizeof(selcall_validator));
+	memset(&tone1750_validator, 0, sizeof(tone1750_validator));
+	selcall_last_digit = 0;
+	dc_acc             = 0;
+	energy             = 0;
+	sample_count       = 0;
+	symbol_rd          = symbol_wr;
+
+	modes = new_modes;
+}
+
+void TONE_DECODER_PushSample(int16_t sample)
+{
+	if (modes == 0)
+		return;
+
+	has_input = true;
+
+	// remove DC (~20Hz high pass)
+	int32_t x = sample - (dc_acc >> 6);
+	dc_acc += x;
+	if (x > 2047)
+		x = 2047;
+	else if (x < -2047)
+		x = -2047;
+
+	energy += x * x;
+
+	for (unsigned i = 0; i < FILTER_N_ELEM; i++) {
+		goertzel_t *f = &filter[i];
+		const int32_t s = x + ((coef[i] * f->s1) >> 10) - f->s2;
+		f->s2 = f->s1;
+		f->s1 = s;
+	}
+
+	if (++sample_count < TONE_DECODER_BLOCK_SIZE)
+		return;
+
+	ProcessBlock();
+
+	memset(filter, 0, sizeof(filter));
+	energy       = 0;
+	sample_count = 0;
+}
+
+bool TONE_DECODER_HasInput(void)
+{
+	const bool input = has_input;
+	has_input = false;
+	return input;
+}
+
+char TONE_DECODER_GetSymbol(TONE_DECODER_Mode_t *mode)
+{
+	if (symbol_rd == symbol_wr)
+		return 0;
+	const char symbol = symbol_buf[symbol_rd];
+	*mode = symbol_mode[symbol_rd];
+	symbol_rd = (symbol_rd + 1) % ARRAY_SIZE(symbol_buf);
+	return symbol;
+}
@@ -0,0 +1,62 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_TONE_DECODER_H
+#define APP_TONE_DECODER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// software selective calling decoder (fixed point Goertzel filters)
+//
+// a fallback for the BK4819's own DTMF decoder, it also does ZVEI1/CCIR
+// 5-tone and 1750Hz. Feed it AF samples at TONE_DECODER_SAMPLE_RATE from the
+// sampling interrupt, and fetch the decoded symbols from the main loop.
+//
+// the stock radio has no way to get AF samples into the MCU (REG_64 is only
+// an amplitude envelope and the AF isn't wired to the SARADC), so nothing in
+// the firmware feeds or polls it yet, only utils/tone_decoder_sim.c does.
+// Each symbol comes with the decoder it came from, ZVEI/CCIR and 1750Hz
+// aren't DTMF and don't belong in gDTMF_RX_live or the DTMF calling.
+
+#define TONE_DECODER_SAMPLE_RATE   8000
+// samples per Goertzel block (20ms), catches DTMF tones down to 40ms
+#define TONE_DECODER_BLOCK_SIZE    160
+
+enum TONE_DECODER_Mode_t {
+	TONE_DECODER_DTMF    = 1u << 0,
+	TONE_DECODER_ZVEI1   = 1u << 1,
+	TONE_DECODER_CCIR    = 1u << 2,
+	TONE_DECODER_1750    = 1u << 3,
+};
+
+typedef enum TONE_DECODER_Mode_t TONE_DECODER_Mode_t;
+
+// symbol returned for a 1750Hz tone burst
+#define TONE_DECODER_SYMBOL_1750   '^'
+
+// ZVEI1 and CCIR can't be decoded at the same time, with CCIR a 1750Hz
+// burst also shows up as an '8' (1747Hz)
+void TONE_DECODER_Init(uint8_t modes);
+// sample is signed AF, DC is removed here, keep it within +/-2047
+void TONE_DECODER_PushSample(int16_t sample);
+// true if samples came in since the last call
+bool TONE_DECODER_HasInput(void);
+// next decoded symbol ('0'-'9', 'A'-'D', '*', '#', TONE_DECODER_SYMBOL_1750),
+// 0 = none. 'mode' tells which decoder it came from
+char TONE_DECODER_GetSymbol(TONE_DECODER_Mode_t *mode);
+
+#endif
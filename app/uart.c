@@ -34,8 +34,15 @@
 #include "driver/gpio.h"
 #include "driver/uart.h"
 #include "functions.h"
+#include "helper/battery.h"
 #include "misc.h"
+#include "name_index.h"
+#include "radio.h"
 #include "settings.h"
+#include "settings_journal.h"
+#ifdef ENABLE_TAIL_STATS
+	#include "tail.h"
+#endif
 #include "version.h"
 
 #if defined(ENABLE_OVERLAY)
@@ -273,8 +280,14 @@ static void CMD_051B(const uint8_t *pBuffer)
 	if (bHasCustomAesKey)
 		bLocked = gIsLocked;
 
-	if (!bLocked)
+	if (!bLocked) {
+		#ifdef ENABLE_SETTINGS_JOURNAL
+			// the VFO indices live in the journal, bring the fixed block up to date for the CPS
+			if (pCmd->Offset <= 0x0E80 && pCmd->Offset + pCmd->Size > 0x0E80)
+				JOURNAL_Export();
+		#endif
 		EEPROM_ReadBuffer(pCmd->Offset, Reply.Data.Data, pCmd->Size);
+	}
 
 	SendReply(&Reply, pCmd->Size + 8);
 }
@@ -285,14 +298,19 @@ static void CMD_051D(const uint8_t *pBuffer)
 	const CMD_051D_t *pCmd = (const CMD_051D_t *)pBuffer;
 	REPLY_051D_t Reply;
 	bool bReloadEeprom;
+	bool bReloadCalibration;
 	bool bIsLocked;
+#ifdef ENABLE_SETTINGS_JOURNAL
+	bool bReloadJournal = false;
+#endif
 
 	if (pCmd->Timestamp != Timestamp)
 		return;
 
 	gSerialConfigCountDown_500ms = 12; // 6 sec
 	
-	bReloadEeprom = false;
+	bReloadEeprom      = false;
+	bReloadCalibration = false;
 
 	#ifdef ENABLE_FMRADIO
 		gFmRadioCountdown_500ms = fm_radio_countdown_500ms;
@@ -315,12 +333,36 @@ static void CMD_051D(const uint8_t *pBuffer)
 				if (!gIsLocked)
 					bReloadEeprom = true;
 
+			// squelch, power and the rest of the calibration are kept in RAM
+			if (Offset >= 0x1E00 && Offset < 0x2000)
+				bReloadCalibration = true;
+
+			#ifdef ENABLE_CHANNEL_NAME_SEARCH
+				if (Offset >= 0x0F50 && Offset < 0x1C00)
+					NAMEIDX_Invalidate();   // read in again on the next search
+			#endif
+
+			#ifdef ENABLE_SETTINGS_JOURNAL
+				if (Offset == 0x0E80 || (Offset >= JOURNAL_ADDRESS && Offset < JOURNAL_ADDRESS + (JOURNAL_SLOTS * 16)))
+					bReloadJournal = true;
+			#endif
+
 			if ((Offset < 0x0E98 || Offset >= 0x0EA0) || !bIsInLockScreen || pCmd->bAllowPassword)
 				EEPROM_WriteBuffer(Offset, &pCmd->Data[i * 8U]);
 		}
 
 		if (bReloadEeprom)
 			SETTINGS_InitEEPROM();
+
+		#ifdef ENABLE_SETTINGS_JOURNAL
+			if (bReloadJournal)
+				JOURNAL_Import();
+		#endif
+
+		if (bReloadCalibration) {
+			SETTINGS_LoadCalibration();
+			gFlagReconfigureVfos = true;
+		}
 	}
 
 	SendReply(&Reply, sizeof(Reply));
@@ -333,7 +375,7 @@ static void CMD_0527(void)
 
 	Reply.Header.ID             = 0x0528;
 	Reply.Header.Size           = sizeof(Reply.Data);
-	Reply.Data.RSSI             = BK4819_ReadRegister(BK4819_REG_67) & 0x01FF;
+	Reply.Data.RSSI             = MIN(RADIO_GetCompensatedRssi(), 0x01FFu);
 	Reply.Data.ExNoiseIndicator = BK4819_ReadRegister(BK4819_REG_65) & 0x007F;
 	Reply.Data.GlitchIndicator  = BK4819_ReadRegister(BK4819_REG_63);
 
@@ -349,7 +391,9 @@ static void CMD_0529(void)
 	Reply.Header.Size = sizeof(Reply.Data);
 
 	// Original doesn't actually send current!
-	BOARD_ADC_GetBatteryInfo(&Reply.Data.Voltage, &Reply.Data.Current);
+	// last readings of BATTERY_TimeSlice10ms(), we're called from the same slice
+	Reply.Data.Voltage = gBatteryCurrentVoltage;
+	Reply.Data.Current = gBatteryCurrent;
 
 	SendReply(&Reply, sizeof(Reply));
 }
@@ -472,6 +516,61 @@ static void CMD_0602_WriteBK4819Reg(const uint8_t *pBuffer)
 }
 #endif
 
+#ifdef ENABLE_TAIL_STATS
+// the squelch tail log, oldest event first
+static void CMD_0603_ReadTailStats(void)
+{
+	struct __attribute__((__packed__)) {
+		Header_t header;
+		struct __attribute__((__packed__)) {
+			uint8_t      count;
+			uint8_t      padding;
+			TAIL_Event_t event[TAIL_STATS_LEN];
+		} data;
+	} reply;
+
+	memset(&reply, 0, sizeof(reply));
+	reply.header.ID = 0x0603;
+	reply.header.Size = sizeof(reply.data);
+	reply.data.count = gTAIL_Stats.count;
+
+	const unsigned int first = (gTAIL_Stats.head + TAIL_STATS_LEN - gTAIL_Stats.count) % TAIL_STATS_LEN;
+	for (unsigned int i = 0; i < gTAIL_Stats.count; i++)
+		reply.data.event[i] = gTAIL_Stats.event[(first + i) % TAIL_STATS_LEN];
+
+	SendReply(&reply, sizeof(reply));
+}
+#endif
+
+// power save duty cycle since the last read, cleared once sent
+static void CMD_0604_ReadPowerSaveStats(void)
+{
+	struct __attribute__((__packed__)) {
+		Header_t         header;
+		PowerSaveStats_t data;
+	} reply;
+
+	reply.header.ID = 0x0604;
+	reply.header.Size = sizeof(reply.data);
+	reply.data = gPowerSaveStats;
+	memset((void *)&gPowerSaveStats, 0, sizeof(gPowerSaveStats));
+	SendReply(&reply, sizeof(reply));
+}
+
+// keying time of the last TX, RADIO_PrepareTX() to the PA on, in us
+static void CMD_0605_ReadTxSetupTime(void)
+{
+	struct __attribute__((__packed__)) {
+		Header_t header;
+		uint32_t time_us;
+	} reply;
+
+	reply.header.ID = 0x0605;
+	reply.header.Size = sizeof(reply.time_us);
+	reply.time_us = gTxSetup_us;
+	SendReply(&reply, sizeof(reply));
+}
+
 bool UART_IsCommandAvailable(void)
 {
 	uint16_t Index;
@@ -604,6 +703,9 @@ void UART_HandleCommand(void)
 			break;
 	
 		case 0x05DD: // reset
+			#ifdef ENABLE_DEFERRED_SAVES
+				EEPROM_Flush();   // the reset would drop whatever is still waiting
+			#endif
 			#if defined(ENABLE_OVERLAY)
 				overlay_FLASH_RebootToBootloader();
 			#else
@@ -620,5 +722,19 @@ void UART_HandleCommand(void)
 			CMD_0602_WriteBK4819Reg(UART_Command.Buffer);
 			break;
 #endif
+
+#ifdef ENABLE_TAIL_STATS
+		case 0x0603:
+			CMD_0603_ReadTailStats();
+			break;
+#endif
+
+		case 0x0604:
+			CMD_0604_ReadPowerSaveStats();
+			break;
+
+		case 0x0605:
+			CMD_0605_ReadTxSetupTime();
+			break;
 	}
 }
@@ -0,0 +1,156 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifdef ENABLE_SW_VOX
+
+#include "app/vox.h"
+
+#define FLOOR_SHIFT    4
+
+static enum {
+	STATE_OFF = 0,
+	STATE_IDLE,
+	STATE_ARMED,
+	STATE_ACTIVE,
+	STATE_HOLD
+} state;
+
+static uint16_t on_margin;
+static uint16_t off_margin;
+static uint32_t noise_floor;   // << FLOOR_SHIFT, 0 until the first sample
+static uint16_t count;         // ARMED: samples above on, HOLD: samples below off
+static uint16_t window;        // ACTIVE/HOLD: samples into the floor window
+static uint16_t window_min;
+static uint16_t window_max;
+
+void VOX_Start(uint16_t OnThreshold, uint16_t OffThreshold)
+{
+	on_margin  = OnThreshold;
+	off_margin = (OffThreshold < OnThreshold) ? OffThreshold : OnThreshold;
+	state      = STATE_IDLE;
+}
+
+void VOX_Stop(void)
+{
+	state = STATE_OFF;
+}
+
+bool VOX_IsRunning(void)
+{
+	return state != STATE_OFF;
+}
+
+uint16_t VOX_GetFloor(void)
+{
+	return noise_floor >> FLOOR_SHIFT;
+}
+
+static void StartWindow(void)
+{
+	window     = 0;
+	window_min = 0xFFFF;
+	window_max = 0;
+}
+
+// true if nothing in the window stood out from the background
+static bool TrackWindow(const uint16_t Amp)
+{
+	if (Amp < window_min)
+		window_min = Amp;
+	if (Amp > window_max)
+		window_max = Amp;
+
+	if (++window < VOX_WINDOW_10ms)
+		return false;
+
+	// no pause quiet enough in all that time, the background's come up
+	if (window_min > VOX_GetFloor())
+		noise_floor = (uint32_t)window_min << FLOOR_SHIFT;
+
+	const bool quiet = window_max < VOX_GetFloor() + on_margin;
+
+	StartWindow();
+
+	return quiet;
+}
+
+VOX_Event_t VOX_Sample(const uint16_t Amp)
+{
+	if (state == STATE_OFF)
+		return VOX_EVENT_NONE;
+
+	if (noise_floor == 0)
+		noise_floor = (uint32_t)Amp << FLOOR_SHIFT;
+
+	const uint32_t amp   = (uint32_t)Amp << FLOOR_SHIFT;
+	const uint16_t level = VOX_GetFloor();
+	const uint16_t on    = level + on_margin;
+	const uint16_t off   = level + off_margin;
+
+	switch (state) {
+		default:
+		case STATE_IDLE:
+			if (Amp >= on) {
+				state = STATE_ARMED;
+				count = 1;
+				return VOX_EVENT_ARM;
+			}
+
+			if (amp < noise_floor)
+				noise_floor -= (noise_floor - amp) >> VOX_FLOOR_FALL_SHIFT;
+			else
+				noise_floor += (amp - noise_floor) >> VOX_FLOOR_RISE_SHIFT;
+			break;
+
+		case STATE_ARMED:
+			if (Amp < off) {
+				state = STATE_IDLE;
+				return VOX_EVENT_CANCEL;
+			}
+
+			if (Amp >= on && ++count >= VOX_ATTACK_10ms) {
+				state = STATE_ACTIVE;
+				StartWindow();
+				return VOX_EVENT_START;
+			}
+			break;
+
+		case STATE_ACTIVE:
+		case STATE_HOLD:
+			if (TrackWindow(Amp)) {
+				// steady noise that got in as it came up, not voice
+				state = STATE_IDLE;
+				return VOX_EVENT_STOP;
+			}
+
+			if (Amp >= off) {
+				state = STATE_ACTIVE;
+			}
+			else if (state == STATE_ACTIVE) {
+				state = STATE_HOLD;
+				count = 1;
+			}
+			else if (++count >= VOX_HOLD_10ms) {
+				state = STATE_IDLE;
+				return VOX_EVENT_STOP;
+			}
+			break;
+	}
+
+	return VOX_EVENT_NONE;
+}
+
+#endif
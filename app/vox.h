@@ -0,0 +1,70 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_VOX_H
+#define APP_VOX_H
+
+#ifdef ENABLE_SW_VOX
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// software VOX
+//
+// takes over from the BK4819's VOX interrupts, which only compare the mic
+// level against the two fixed thresholds. The level (REG_64) is read every
+// 10ms tick and the thresholds are taken as margins above a noise floor
+// that follows the quiet moments, so a fan or traffic noise doesn't keep
+// the radio keyed, and a quiet room gets the full sensitivity.
+//
+// the first sample above the on threshold arms it (HandleVox() gets the
+// radio awake and onto the TX VFO straight away), it keys up once the level
+// has been there for VOX_ATTACK_10ms, a click or a knock is over before that
+// and cancels it. It lets go after VOX_HOLD_10ms below the off threshold.
+// `make vox_sim` runs it against mic envelopes and shows the keying delay
+// and false triggers next to the BK4819's algorithm
+
+#ifndef VOX_ATTACK_10ms
+	#define VOX_ATTACK_10ms        3      // above the on threshold this long to key up
+#endif
+#ifndef VOX_HOLD_10ms
+	#define VOX_HOLD_10ms          30     // below the off threshold this long to let go, HandleVox() adds a second
+#endif
+#ifndef VOX_WINDOW_10ms
+	#define VOX_WINDOW_10ms        200    // keyed, the floor follows the quietest moment of each window
+#endif
+#define VOX_FLOOR_RISE_SHIFT       9      // idle, the floor creeps up in ~5s
+#define VOX_FLOOR_FALL_SHIFT       2      // and drops in ~40ms
+
+typedef enum {
+	VOX_EVENT_NONE = 0,
+	VOX_EVENT_ARM,        // level's up, might be voice
+	VOX_EVENT_CANCEL,     // it wasn't
+	VOX_EVENT_START,      // voice, key up
+	VOX_EVENT_STOP        // gone quiet, let go
+} VOX_Event_t;
+
+// thresholds are in REG_64 units above the noise floor, the floor is kept
+void        VOX_Start(uint16_t OnThreshold, uint16_t OffThreshold);
+void        VOX_Stop(void);
+bool        VOX_IsRunning(void);
+// every 10ms with the REG_64 mic level
+VOX_Event_t VOX_Sample(uint16_t Amp);
+uint16_t    VOX_GetFloor(void);
+
+#endif
+
+#endif
@@ -34,6 +34,188 @@
 
 BEEP_Type_t gBeepToPlay = BEEP_NONE;
 
+typedef struct {
+	AUDIO_SeqAction_t action;
+	uint16_t          arg;
+	uint16_t          hold_ms;
+} SeqStep_t;
+
+static SeqStep_t seqSteps[64];
+static uint8_t   seqReadIndex;
+static uint8_t   seqWriteIndex;
+static uint16_t  seqHold_10ms;
+
+static uint16_t  beepToneConfig;
+
+// run the queued steps until one of them wants to hold for a tick or more,
+// shorter holds (register settling) are just waited out here
+static void SeqRun(void)
+{
+	while (seqReadIndex != seqWriteIndex) {
+		const SeqStep_t step = seqSteps[seqReadIndex];
+		seqReadIndex = (seqReadIndex + 1) % ARRAY_SIZE(seqSteps);
+
+		if (step.action)
+			step.action(step.arg);
+
+		if (step.hold_ms >= 10) {
+			seqHold_10ms = (step.hold_ms + 5) / 10;
+			return;
+		}
+
+		if (step.hold_ms > 0)
+			SYSTEM_DelayMs(step.hold_ms);
+	}
+}
+
+void AUDIO_SeqAdd(AUDIO_SeqAction_t action, uint16_t arg, uint16_t hold_ms)
+{
+	const uint8_t next = (seqWriteIndex + 1) % ARRAY_SIZE(seqSteps);
+	if (next == seqReadIndex)
+		AUDIO_SeqFinish();	// no room, play out what's queued the old way
+
+	seqSteps[seqWriteIndex].action  = action;
+	seqSteps[seqWriteIndex].arg     = arg;
+	seqSteps[seqWriteIndex].hold_ms = hold_ms;
+	seqWriteIndex = next;
+}
+
+void AUDIO_SeqCall(AUDIO_SeqAction_t action, uint16_t arg)
+{
+	if (AUDIO_SeqBusy())
+		AUDIO_SeqAdd(action, arg, 0);
+	else
+		action(arg);
+}
+
+bool AUDIO_SeqBusy(void)
+{
+	return seqReadIndex != seqWriteIndex || seqHold_10ms > 0;
+}
+
+void AUDIO_SeqFinish(void)
+{
+	if (seqHold_10ms > 0) {
+		SYSTEM_DelayMs(seqHold_10ms * 10);
+		seqHold_10ms = 0;
+	}
+
+	while (seqReadIndex != seqWriteIndex) {
+		const SeqStep_t step = seqSteps[seqReadIndex];
+		seqReadIndex = (seqReadIndex + 1) % ARRAY_SIZE(seqSteps);
+
+		if (step.action)
+			step.action(step.arg);
+		SYSTEM_DelayMs(step.hold_ms);
+	}
+}
+
+void AUDIO_SeqTimeSlice10ms(void)
+{
+	if (seqHold_10ms > 0 && --seqHold_10ms > 0)
+		return;
+
+	SeqRun();
+}
+
+void AUDIO_SeqTxMute(uint16_t mute)
+{
+	if (mute)
+		BK4819_EnterTxMute();
+	else
+		BK4819_ExitTxMute();
+}
+
+void AUDIO_SeqAudioPath(uint16_t on)
+{
+	if (on)
+		AUDIO_AudioPathOn();
+	else
+		AUDIO_AudioPathOff();
+}
+
+static void SingleToneStart(uint16_t arg)
+{
+	BK4819_StartSingleTone(arg & 0x7F, arg & 0x80);
+}
+
+static void SingleToneOn(uint16_t tone_Hz)
+{
+	BK4819_SetTone1Frequency(tone_Hz);
+	BK4819_ExitTxMute();
+}
+
+static void SingleToneStop(uint16_t arg)
+{
+	BK4819_StopSingleTone(arg & 1, arg & 2);
+}
+
+void AUDIO_SeqSingleTone(uint16_t tone_Hz, uint16_t duration_ms, uint8_t level, bool play_speaker, bool bKeepMute)
+{
+	AUDIO_SeqAdd(SingleToneStart, (level & 0x7F) | (play_speaker ? 0x80 : 0), 50);
+	AUDIO_SeqAdd(SingleToneOn, tone_Hz, duration_ms);
+	AUDIO_SeqAdd(SingleToneStop, (play_speaker ? 1 : 0) | (bKeepMute ? 2 : 0), 0);
+}
+
+// AUDIO_SeqSingleTone() with the tone changing half way
+void AUDIO_SeqTwoTone(uint16_t tone1_Hz, uint16_t tone2_Hz, uint16_t duration_ms, uint8_t level, bool bKeepMute)
+{
+	AUDIO_SeqAdd(SingleToneStart, level & 0x7F, 50);
+	AUDIO_SeqAdd(SingleToneOn, tone1_Hz, duration_ms);
+	AUDIO_SeqAdd(AUDIO_SeqTxMute, true, 0);
+	AUDIO_SeqAdd(SingleToneOn, tone2_Hz, duration_ms);
+	AUDIO_SeqAdd(SingleToneStop, bKeepMute ? 2 : 0, 0);
+}
+
+static void BeepStart(uint16_t unused)
+{
+	(void)unused;
+
+#ifdef ENABLE_FMRADIO
+	if (gFmRadioMode)
+		BK1080_Mute(true);
+#endif
+
+	AUDIO_AudioPathOff();
+
+	if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
+		BK4819_RX_TurnOn();
+}
+
+static void BeepTone(uint16_t ToneFrequency)
+{
+	beepToneConfig = BK4819_ReadRegister(BK4819_REG_71);
+	BK4819_PlayTone(ToneFrequency, true);
+}
+
+static void BeepTonesOff(uint16_t unused)
+{
+	(void)unused;
+	BK4819_TurnsOffTones_TurnsOnRX();
+}
+
+static void BeepEnd(uint16_t unused)
+{
+	(void)unused;
+
+	BK4819_WriteRegister(BK4819_REG_71, beepToneConfig);
+
+	if (gEnableSpeaker)
+		AUDIO_AudioPathOn();
+
+#ifdef ENABLE_FMRADIO
+	if (gFmRadioMode)
+		BK1080_Mute(false);
+#endif
+
+	if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
+		BK4819_Sleep();
+
+#ifdef ENABLE_VOX
+	gVoxResumeCountdown = 80;
+#endif
+}
+
 void AUDIO_PlayBeep(BEEP_Type_t Beep)
 {
 
@@ -56,20 +238,6 @@ void AUDIO_PlayBeep(BEEP_Type_t Beep)
 	if (gCurrentFunction == FUNCTION_MONITOR)
 		return;
 
-#ifdef ENABLE_FMRADIO
-	if (gFmRadioMode)
-		BK1080_Mute(true);
-#endif
-
-	AUDIO_AudioPathOff();
-
-	if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
-		BK4819_RX_TurnOn();
-
-	SYSTEM_DelayMs(20);
-
-	uint16_t ToneConfig = BK4819_ReadRegister(BK4819_REG_71);
-
 	uint16_t ToneFrequency;
 	switch (Beep)
 	{
@@ -96,77 +264,44 @@ void AUDIO_PlayBeep(BEEP_Type_t Beep)
 			break;
 	}
 
-	BK4819_PlayTone(ToneFrequency, true);
-
-	SYSTEM_DelayMs(2);
-
-	AUDIO_AudioPathOn();
-
-	SYSTEM_DelayMs(60);
+	AUDIO_SeqAdd(BeepStart, 0, 20);
+	AUDIO_SeqAdd(BeepTone, ToneFrequency, 2);
+	AUDIO_SeqAdd(AUDIO_SeqAudioPath, true, 60);
 
 	uint16_t Duration;
 	switch (Beep)
 	{
 		case BEEP_880HZ_60MS_TRIPLE_BEEP:
-			BK4819_ExitTxMute();
-			SYSTEM_DelayMs(60);
-			BK4819_EnterTxMute();
-			SYSTEM_DelayMs(20);
+			AUDIO_SeqAdd(AUDIO_SeqTxMute, false, 60);
+			AUDIO_SeqAdd(AUDIO_SeqTxMute, true, 20);
 			[[fallthrough]];
 		case BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL:
 		case BEEP_500HZ_60MS_DOUBLE_BEEP:
-			BK4819_ExitTxMute();
-			SYSTEM_DelayMs(60);
-			BK4819_EnterTxMute();
-			SYSTEM_DelayMs(20);
+			AUDIO_SeqAdd(AUDIO_SeqTxMute, false, 60);
+			AUDIO_SeqAdd(AUDIO_SeqTxMute, true, 20);
 			[[fallthrough]];
 		case BEEP_1KHZ_60MS_OPTIONAL:
-			BK4819_ExitTxMute();
 			Duration = 60;
 			break;
 		case BEEP_880HZ_40MS_OPTIONAL:
 		case BEEP_440HZ_40MS_OPTIONAL:
-			BK4819_ExitTxMute();
 			Duration = 40;
 			break;
 		case BEEP_880HZ_200MS:
-			BK4819_ExitTxMute();
 			Duration = 200;
 			break;
 		case BEEP_440HZ_500MS:
 		case BEEP_880HZ_500MS:
 		default:
-			BK4819_ExitTxMute();
 			Duration = 500;
 			break;
 	}
 
-	SYSTEM_DelayMs(Duration);
-	BK4819_EnterTxMute();
-	SYSTEM_DelayMs(20);
-
-	AUDIO_AudioPathOff();
-
-	SYSTEM_DelayMs(5);
-	BK4819_TurnsOffTones_TurnsOnRX();
-	SYSTEM_DelayMs(5);
-	BK4819_WriteRegister(BK4819_REG_71, ToneConfig);
-
-	if (gEnableSpeaker)
-		AUDIO_AudioPathOn();
-
-#ifdef ENABLE_FMRADIO
-	if (gFmRadioMode)
-		BK1080_Mute(false);
-#endif
-
-	if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
-		BK4819_Sleep();
-
-#ifdef ENABLE_VOX
-	gVoxResumeCountdown = 80;
-#endif
-
+	AUDIO_SeqAdd(AUDIO_SeqTxMute, false, Duration);
+	AUDIO_SeqAdd(AUDIO_SeqTxMute, true, 20);
+	AUDIO_SeqAdd(AUDIO_SeqAudioPath, false, 5);
+	AUDIO_SeqAdd(BeepTonesOff, 0, 5);
+	AUDIO_SeqAdd(BeepEnd, 0, 0);
 }
 
 #ifdef ENABLE_VOICE
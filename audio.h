@@ -43,6 +43,26 @@ extern BEEP_Type_t       gBeepToPlay;
 
 void AUDIO_PlayBeep(BEEP_Type_t Beep);
 
+// tone sequencer .. beeps, roger and DTMF/PTT-ID tones are queued as steps
+// and played out from the 10ms time slice instead of stalling the main loop,
+// each step calls 'action(arg)' (if any) and then holds for 'hold_ms'
+typedef void (*AUDIO_SeqAction_t)(uint16_t arg);
+
+void AUDIO_SeqAdd(AUDIO_SeqAction_t action, uint16_t arg, uint16_t hold_ms);
+// run 'action' now, or after the queued steps if there are any
+void AUDIO_SeqCall(AUDIO_SeqAction_t action, uint16_t arg);
+bool AUDIO_SeqBusy(void);
+// play out the queued steps right now, for anything that's about to
+// reconfigure the BK4819
+void AUDIO_SeqFinish(void);
+void AUDIO_SeqTimeSlice10ms(void);
+
+void AUDIO_SeqTxMute(uint16_t mute);
+void AUDIO_SeqAudioPath(uint16_t on);
+// level 0 ~ 127
+void AUDIO_SeqSingleTone(uint16_t tone_Hz, uint16_t duration_ms, uint8_t level, bool play_speaker, bool bKeepMute);
+void AUDIO_SeqTwoTone(uint16_t tone1_Hz, uint16_t tone2_Hz, uint16_t duration_ms, uint8_t level, bool bKeepMute);
+
 enum
 {
 	VOICE_ID_CHI_BASE = 0x10U,
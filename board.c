@@ -479,12 +479,26 @@ void BOARD_ADC_Init(void)
 	ADC_SoftReset();
 }
 
-void BOARD_ADC_GetBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent)
+void BOARD_ADC_StartBatteryInfo(void)
 {
 	ADC_Start();
-	while (!ADC_CheckEndOfConversion(ADC_CH9)) {}
+}
+
+bool BOARD_ADC_ReadBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent)
+{
+	// CH9 is the last one of the scan
+	if (!ADC_CheckEndOfConversion(ADC_CH9))
+		return false;
+
 	*pVoltage = ADC_GetValue(ADC_CH4);
 	*pCurrent = ADC_GetValue(ADC_CH9);
+	return true;
+}
+
+void BOARD_ADC_GetBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent)
+{
+	BOARD_ADC_StartBatteryInfo();
+	while (!BOARD_ADC_ReadBatteryInfo(pVoltage, pCurrent)) {}
 }
 
 void BOARD_Init(void)
@@ -498,7 +512,7 @@ void BOARD_Init(void)
 	BK1080_Init0();
 #endif
 
-#if defined(ENABLE_UART) || defined(ENABLED_AIRCOPY)
+#if defined(ENABLE_UART) || defined(ENABLE_FSK_PACKETS)
 	CRC_Init();
 #endif
 
@@ -24,6 +24,8 @@ void     BOARD_FLASH_Init(void);
 void     BOARD_GPIO_Init(void);
 void     BOARD_PORTCON_Init(void);
 void     BOARD_ADC_Init(void);
+void     BOARD_ADC_StartBatteryInfo(void);
+bool     BOARD_ADC_ReadBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent);
 void     BOARD_ADC_GetBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent);
 void     BOARD_Init(void);
 
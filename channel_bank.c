@@ -0,0 +1,253 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifdef ENABLE_CHANNEL_BANKS
+
+#include <string.h>
+
+#include "channel_bank.h"
+#include "driver/st7565.h"
+#include "frequencies.h"
+#include "misc.h"
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	#include "name_index.h"
+#endif
+#include "ui/helper.h"
+
+// directory[5] is the bank a load is going into, 0xFF when there's none
+#define NOT_LOADING          0xFF
+
+// 8 byte blocks out to the EEPROM, the banks start on a block
+typedef struct {
+	uint16_t address;
+	uint8_t  fill;
+	uint8_t  block[8];
+} Writer_t;
+
+static void Write(Writer_t *w, const void *pData, uint8_t Size)
+{
+	const uint8_t *p = pData;
+
+	while (Size-- > 0) {
+		w->block[w->fill++] = *p++;
+		if (w->fill == sizeof(w->block)) {
+			EEPROM_WriteBuffer(w->address, w->block);
+			w->address += sizeof(w->block);
+			w->fill     = 0;
+		}
+	}
+}
+
+static void Finish(Writer_t *w)
+{
+	if (w->fill > 0) {
+		memset(w->block + w->fill, 0xFF, sizeof(w->block) - w->fill);
+		EEPROM_WriteBuffer(w->address, w->block);
+	}
+}
+
+static bool Fetch(uint8_t Channel, CHCODEC_Stock_t *pStock)
+{
+	pStock->attributes = gMR_ChannelAttributes[Channel].__val;
+	if (gMR_ChannelAttributes[Channel].band > BAND7_470MHz)
+		return false;   // empty
+
+	EEPROM_ReadBuffer(Channel * 16, pStock->data, sizeof(pStock->data));
+	EEPROM_ReadBuffer(0x0F50 + (Channel * 16), pStock->name, sizeof(pStock->name));
+	return true;
+}
+
+// straight to a channel's record through the index
+static bool Lookup(uint16_t Base, uint8_t Channel, CHCODEC_Stock_t *pStock)
+{
+	uint8_t  record[1 + CHCODEC_MAX_SIZE];
+	uint16_t offset;
+
+	EEPROM_ReadBuffer(Base + CHBANK_INDEX + (Channel * 2), &offset, sizeof(offset));
+	if (offset == CHBANK_EMPTY || offset < CHBANK_RECORDS || offset >= CHBANK_SIZE - 1)
+		return false;
+
+	const unsigned int left = CHBANK_SIZE - offset;
+	const uint8_t      size = (left < sizeof(record)) ? left : sizeof(record);
+	EEPROM_ReadBuffer(Base + offset, record, size);
+	if (record[0] == 0 || record[0] >= size)
+		return false;
+
+	return CHCODEC_Decode(record + 1, record[0], pStock);
+}
+
+// a store/load rewrites a couple of thousand bytes, say so while it does
+static void Busy(void)
+{
+	UI_DisplayClear();
+	UI_PrintString("BANK..", 9, 118, 2, 8);
+	ST7565_BlitFullScreen();
+}
+
+static bool ReadDirectory(uint8_t *pDirectory)
+{
+	EEPROM_ReadBuffer(CHBANK_DIRECTORY, pDirectory, 8);
+	return pDirectory[0] == CHBANK_MAGIC_0 && pDirectory[1] == CHBANK_MAGIC_1 && pDirectory[2] == 'D' &&
+	       pDirectory[3] == CHBANK_VERSION && (pDirectory[4] < CHBANK_COUNT || pDirectory[4] == CHBANK_NONE);
+}
+
+static void WriteDirectory(uint8_t Current, uint8_t Loading)
+{
+	const uint8_t directory[8] = {CHBANK_MAGIC_0, CHBANK_MAGIC_1, 'D', CHBANK_VERSION, Current, Loading, 0xFF, 0xFF};
+	EEPROM_WriteBuffer(CHBANK_DIRECTORY, directory);
+}
+
+bool CHBANK_Resume(void)
+{
+	uint8_t directory[8];
+
+	if (!ReadDirectory(directory) || directory[5] >= CHBANK_COUNT)
+		return false;
+
+	// the channels are part one bank and part the other, the bank being
+	// loaded is still whole so load it again from the start
+	Busy();
+	CHBANK_Load(directory[5]);
+	return true;
+}
+
+// no directory yet, the channels in use are bank 0's
+uint8_t CHBANK_GetCurrent(void)
+{
+	uint8_t directory[8];
+
+	return ReadDirectory(directory) ? directory[4] : 0;
+}
+
+void CHBANK_Forget(void)
+{
+	WriteDirectory(CHBANK_NONE, NOT_LOADING);
+}
+
+bool CHBANK_Store(uint8_t Bank)
+{
+	uint8_t         sizes[CHBANK_CHANNELS];
+	uint8_t         record[CHCODEC_MAX_SIZE];
+	uint16_t        offset = CHBANK_RECORDS;
+	CHCODEC_Stock_t stock;
+
+	if (Bank >= CHBANK_COUNT)
+		return false;
+
+	// sizes first, a bank that doesn't fit is left as it was
+	for (unsigned int i = 0; i < CHBANK_CHANNELS; i++) {
+		sizes[i] = Fetch(i, &stock) ? CHCODEC_Encode(&stock, record) : 0;
+		if (sizes[i] > 0)
+			offset += 1 + sizes[i];
+	}
+	if (offset > CHBANK_SIZE)
+		return false;
+
+	Writer_t      w         = {.address = CHBANK_ADDRESS + (Bank * CHBANK_SIZE)};
+	const uint8_t header[4] = {CHBANK_MAGIC_0, CHBANK_MAGIC_1, CHBANK_VERSION, CHBANK_CHANNELS};
+
+	Write(&w, header, sizeof(header));
+
+	offset = CHBANK_RECORDS;
+	for (unsigned int i = 0; i < CHBANK_CHANNELS; i++) {
+		const uint16_t index = (sizes[i] > 0) ? offset : CHBANK_EMPTY;
+		Write(&w, &index, sizeof(index));
+		if (sizes[i] > 0)
+			offset += 1 + sizes[i];
+	}
+
+	for (unsigned int i = 0; i < CHBANK_CHANNELS; i++) {
+		if (sizes[i] == 0)
+			continue;
+		Fetch(i, &stock);
+		CHCODEC_Encode(&stock, record);
+		Write(&w, &sizes[i], 1);
+		Write(&w, record, sizes[i]);
+	}
+
+	Finish(&w);
+
+	return true;
+}
+
+void CHBANK_Load(uint8_t Bank)
+{
+	const uint16_t  base = CHBANK_ADDRESS + (Bank * CHBANK_SIZE);
+	uint8_t         directory[8];
+	uint8_t         header[4];
+	uint8_t         attributes[8];
+	CHCODEC_Stock_t stock;
+
+	// mark the load first, a power cut part way through then finishes it
+	// on the next CHBANK_Resume() rather than storing the mix over a bank
+	WriteDirectory(ReadDirectory(directory) ? directory[4] : 0, Bank);
+
+	// never stored, an empty bank
+	EEPROM_ReadBuffer(base, header, sizeof(header));
+	const bool valid = Bank < CHBANK_COUNT && header[0] == CHBANK_MAGIC_0 && header[1] == CHBANK_MAGIC_1 &&
+	                   header[2] == CHBANK_VERSION && header[3] == CHBANK_CHANNELS;
+
+	for (unsigned int i = 0; i < CHBANK_CHANNELS; i++) {
+		uint8_t name[16] = {0};
+
+		if (!valid || !Lookup(base, i, &stock)) {
+			memset(stock.data, 0xFF, sizeof(stock.data));
+			stock.attributes = 0xFF;
+		}
+		else {
+			memcpy(name, stock.name, sizeof(stock.name));
+		}
+
+		EEPROM_WriteBuffer((i * 16) + 0, stock.data);
+		EEPROM_WriteBuffer((i * 16) + 8, stock.data + 8);
+		EEPROM_WriteBuffer(0x0F50 + (i * 16), name);
+		EEPROM_WriteBuffer(0x0F58 + (i * 16), name + 8);
+
+		gMR_ChannelAttributes[i].__val = stock.attributes;
+		attributes[i & 7u] = stock.attributes;
+		if ((i & 7u) == 7u)
+			EEPROM_WriteBuffer(0x0D60 + (i & ~7u), attributes);
+	}
+
+	#ifdef ENABLE_CHANNEL_NAME_SEARCH
+		NAMEIDX_Invalidate();
+	#endif
+
+	WriteDirectory(Bank, NOT_LOADING);
+}
+
+bool CHBANK_Select(uint8_t Bank)
+{
+	if (Bank >= CHBANK_COUNT)
+		return false;
+
+	// never store a half loaded set over a bank, boot should have caught it
+	CHBANK_Resume();
+
+	const uint8_t current = CHBANK_GetCurrent();
+	if (Bank == current)
+		return true;
+
+	Busy();
+
+	if (current != CHBANK_NONE && !CHBANK_Store(current))
+		return false;
+
+	CHBANK_Load(Bank);
+	return true;
+}
+
+#endif
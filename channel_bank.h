@@ -0,0 +1,60 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef CHANNEL_BANK_H
+#define CHANNEL_BANK_H
+
+#ifdef ENABLE_CHANNEL_BANKS
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "channel_codec.h"
+#include "driver/eeprom.h"
+
+// memory channel banks, for a radio with a bigger EEPROM than the stock 8KB
+//
+// the 200 channels at 0x0000 stay where the CPS, CHIRP and the rest of the
+// firmware expect them, the banks above 0x2000 hold more sets of them in
+// compact records (channel_codec.h), 5KB a bank. Selecting a bank saves the
+// channels into the bank they came from and loads the new one over them.
+// A bank image from `chan_pack` can go straight in over the UART
+
+#if EEPROM_SIZE_KB < 16
+	#error "ENABLE_CHANNEL_BANKS needs a 24C128 or bigger, set EEPROM_SIZE_KB"
+#endif
+
+#define CHBANK_DIRECTORY     0x2000     // 'C' 'B' 'D' version, the bank loaded, the bank being loaded
+#define CHBANK_ADDRESS       0x2100
+#define CHBANK_SIZE          0x1400
+#define CHBANK_COUNT         ((uint8_t)((EEPROM_SIZE_KB * 1024UL - CHBANK_ADDRESS) / CHBANK_SIZE))
+#define CHBANK_NONE          0xFF       // the channels in use aren't from a bank, after a full reset
+
+// finishes a load the power went off in, true if there was one. At boot,
+// a load takes up to ~10s
+bool    CHBANK_Resume(void);
+// the directory only, CHBANK_NONE if the channels belong to no bank
+uint8_t CHBANK_GetCurrent(void);
+// the channels were wiped, the next switch mustn't store them over a bank
+void    CHBANK_Forget(void);
+// false if the channels don't fit in their bank, nothing's changed then
+bool    CHBANK_Select(uint8_t Bank);
+bool    CHBANK_Store(uint8_t Bank);
+void    CHBANK_Load(uint8_t Bank);
+
+#endif
+
+#endif
@@ -0,0 +1,317 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "channel_codec.h"
+
+// the bottom of each band in frequencyBandTable, the RX frequency's
+// kept as the distance from there
+static const uint32_t bandBase[] = {
+	 1800000,
+	10800000,
+	13700000,
+	17400000,
+	35000000,
+	40000000,
+	47000000
+};
+
+// the channel grids, the first one that fits both frequencies is used
+static const uint16_t grids[] = {1250, 625, 500, 250, 100, 10, 1};
+
+// name tokens, 0..46 the characters, then the words, then the escape
+static const char charset[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-./#*+_()!";
+
+static const char * const words[] = {
+	"RPT", "CH", "PMR", "FRS", "GMRS", "LPD", "AIR", "MAR",
+	"WX", "APRS", "TWR", "ATIS", "GND", "SAT", "ISS", "LOCAL"
+};
+
+#define TOKEN_WORDS          (sizeof(charset) - 1)
+#define TOKEN_ESCAPE         63
+
+typedef struct {
+	uint8_t *p;
+	uint16_t bit;
+	uint16_t size;   // bits, reading
+	bool     error;
+} Bits_t;
+
+static void Put(Bits_t *b, uint32_t Value, uint8_t Bits)
+{
+	for (uint8_t i = 0; i < Bits; i++, b->bit++) {
+		if (b->bit >= CHCODEC_MAX_SIZE * 8) {
+			b->error = true;
+			return;
+		}
+		if ((b->bit & 7) == 0)
+			b->p[b->bit >> 3] = 0;
+		if (Value & (1u << i))
+			b->p[b->bit >> 3] |= 1u << (b->bit & 7);
+	}
+}
+
+static uint32_t Get(Bits_t *b, uint8_t Bits)
+{
+	uint32_t value = 0;
+
+	for (uint8_t i = 0; i < Bits; i++, b->bit++) {
+		if (b->bit >= b->size) {
+			b->error = true;
+			return 0;
+		}
+		if (b->p[b->bit >> 3] & (1u << (b->bit & 7)))
+			value |= 1u << i;
+	}
+
+	return value;
+}
+
+static void PutVar(Bits_t *b, uint32_t Value)
+{
+	uint8_t bits = 0;
+
+	while (bits < 31 && (Value >> bits) != 0)
+		bits++;
+
+	Put(b, bits, 5);
+	Put(b, Value, bits);
+}
+
+static uint32_t GetVar(Bits_t *b)
+{
+	return Get(b, Get(b, 5));
+}
+
+static uint8_t Grid(uint32_t Frequency)
+{
+	uint8_t i = 0;
+	while (Frequency % grids[i])
+		i++;
+	return i;
+}
+
+static uint32_t ReadU32(const uint8_t *p)
+{
+	return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void WriteU32(uint8_t *p, uint32_t Value)
+{
+	p[0] = Value;
+	p[1] = Value >> 8;
+	p[2] = Value >> 16;
+	p[3] = Value >> 24;
+}
+
+// false if a field is out of the range the compact fields hold
+static bool PutChannel(Bits_t *b, const uint8_t *pData, uint8_t Band)
+{
+	const uint32_t frequency = ReadU32(pData);
+	const uint32_t offset    = ReadU32(pData + 4);
+	const uint32_t base      = (Band < sizeof(bandBase) / sizeof(bandBase[0])) ? bandBase[Band] : 0;
+
+	if (frequency < base || frequency - base >= (1u << 31) || offset >= (1u << 31))
+		return false;
+	if ((pData[11] >> 4) > 7 || (pData[11] & 0x0F) > 3 || pData[14] > 31 || pData[15] > 15)
+		return false;
+	if ((pData[10] & 0x0F) > 3 || (pData[10] >> 4) > 3 || pData[8] > 127 || pData[9] > 127)
+		return false;
+	if (((pData[10] & 0x0F) == 0 && pData[8] != 0) || ((pData[10] >> 4) == 0 && pData[9] != 0))
+		return false;   // a code left behind without its type, keep it
+
+	const uint8_t grid = Grid(frequency - base);
+	Put(b, grid, 3);
+	PutVar(b, (frequency - base) / grids[grid]);
+
+	Put(b, pData[11] & 0x0F, 2);
+	Put(b, offset != 0, 1);
+	if (offset != 0) {
+		const uint8_t offset_grid = Grid(offset);
+		Put(b, offset_grid, 3);
+		PutVar(b, offset / grids[offset_grid]);
+	}
+
+	Put(b, pData[11] >> 4, 3);
+	for (uint8_t i = 0; i < 2; i++) {
+		const uint8_t type = (pData[10] >> (i * 4)) & 0x0F;
+		Put(b, type, 2);
+		if (type != 0)
+			Put(b, pData[8 + i], 7);
+	}
+
+	Put(b, pData[12], 8);
+	Put(b, pData[13], 8);
+	Put(b, pData[14], 5);
+	Put(b, pData[15], 4);
+
+	return true;
+}
+
+static void GetChannel(Bits_t *b, uint8_t *pData, uint8_t Band)
+{
+	const uint32_t base  = (Band < sizeof(bandBase) / sizeof(bandBase[0])) ? bandBase[Band] : 0;
+	uint8_t        grid  = Get(b, 3);
+	uint32_t       value = GetVar(b);
+
+	if (grid >= sizeof(grids) / sizeof(grids[0]))
+		b->error = true;
+	else
+		WriteU32(pData, value * grids[grid] + base);
+
+	pData[11] = Get(b, 2);
+	WriteU32(pData + 4, 0);
+	if (Get(b, 1)) {
+		grid  = Get(b, 3);
+		value = GetVar(b);
+		if (grid >= sizeof(grids) / sizeof(grids[0]))
+			b->error = true;
+		else
+			WriteU32(pData + 4, value * grids[grid]);
+	}
+
+	pData[11] |= Get(b, 3) << 4;
+	pData[10]  = 0;
+	for (uint8_t i = 0; i < 2; i++) {
+		const uint8_t type = Get(b, 2);
+		pData[10]   |= type << (i * 4);
+		pData[8 + i] = (type != 0) ? Get(b, 7) : 0;
+	}
+
+	pData[12] = Get(b, 8);
+	pData[13] = Get(b, 8);
+	pData[14] = Get(b, 5);
+	pData[15] = Get(b, 4);
+}
+
+static void PutName(Bits_t *b, const char *pName)
+{
+	uint8_t tokens[sizeof(((CHCODEC_Stock_t *)0)->name) * 2];
+	uint8_t n = 0;
+	uint8_t i = 0;
+	uint8_t length = 0;
+
+	while (length < sizeof(((CHCODEC_Stock_t *)0)->name) && pName[length] != 0x00 && pName[length] != (char)0xFF)
+		length++;
+
+	while (i < length) {
+		uint8_t token = TOKEN_ESCAPE;
+		uint8_t used  = 1;
+
+		// longest word first
+		for (uint8_t w = 0; w < sizeof(words) / sizeof(words[0]); w++) {
+			const uint8_t size = strlen(words[w]);
+			if (size > used && i + size <= length && memcmp(pName + i, words[w], size) == 0) {
+				token = TOKEN_WORDS + w;
+				used  = size;
+			}
+		}
+
+		if (token == TOKEN_ESCAPE) {
+			const char *p = (pName[i] != 0) ? strchr(charset, pName[i]) : NULL;
+			if (p != NULL)
+				token = p - charset;
+		}
+
+		tokens[n++] = token;
+		if (token == TOKEN_ESCAPE)
+			tokens[n++] = pName[i];
+		i += used;
+	}
+
+	// a token count, an escape's byte isn't one
+	uint8_t count = 0;
+	for (i = 0; i < n; i++, count++)
+		if (tokens[i] == TOKEN_ESCAPE)
+			i++;
+
+	Put(b, count, 4);
+	for (i = 0; i < n; i++) {
+		Put(b, tokens[i], 6);
+		if (tokens[i] == TOKEN_ESCAPE)
+			Put(b, tokens[++i], 8);
+	}
+}
+
+static void GetName(Bits_t *b, char *pName)
+{
+	const uint8_t max   = sizeof(((CHCODEC_Stock_t *)0)->name);
+	const uint8_t count = Get(b, 4);
+	uint8_t       n     = 0;
+
+	memset(pName, 0, max);
+
+	for (uint8_t i = 0; i < count && !b->error; i++) {
+		const uint8_t token = Get(b, 6);
+		const char   *p     = NULL;
+		uint8_t       size  = 1;
+		char          c;
+
+		if (token < TOKEN_WORDS) {
+			p = charset + token;
+		}
+		else if (token < TOKEN_WORDS + sizeof(words) / sizeof(words[0])) {
+			p    = words[token - TOKEN_WORDS];
+			size = strlen(p);
+		}
+		else {
+			c = Get(b, 8);
+			p = &c;
+		}
+
+		if (n + size > max) {
+			b->error = true;
+			return;
+		}
+		memcpy(pName + n, p, size);
+		n += size;
+	}
+}
+
+uint8_t CHCODEC_Encode(const CHCODEC_Stock_t *pStock, uint8_t *pOut)
+{
+	Bits_t b = {.p = pOut};
+
+	Put(&b, pStock->attributes, 8);
+	Put(&b, 0, 1);
+	if (!PutChannel(&b, pStock->data, pStock->attributes & 0x0F)) {
+		b.bit = 8;
+		Put(&b, 1, 1);
+		for (uint8_t i = 0; i < sizeof(pStock->data); i++)
+			Put(&b, pStock->data[i], 8);
+	}
+	PutName(&b, pStock->name);
+
+	return b.error ? 0 : (b.bit + 7) / 8;
+}
+
+bool CHCODEC_Decode(const uint8_t *pIn, uint8_t Size, CHCODEC_Stock_t *pStock)
+{
+	Bits_t b = {.p = (uint8_t *)pIn, .size = Size * 8};
+
+	pStock->attributes = Get(&b, 8);
+	if (Get(&b, 1)) {
+		for (uint8_t i = 0; i < sizeof(pStock->data); i++)
+			pStock->data[i] = Get(&b, 8);
+	}
+	else {
+		GetChannel(&b, pStock->data, pStock->attributes & 0x0F);
+	}
+	GetName(&b, pStock->name);
+
+	return !b.error;
+}
@@ -0,0 +1,80 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef CHANNEL_CODEC_H
+#define CHANNEL_CODEC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// compact memory channel records
+//
+// a stock channel takes 33 bytes of EEPROM (16 at channel * 16, a 16 byte
+// name block at 0x0F50 of which 10 are used, and an attribute byte at
+// 0x0D60), the compact record is a bit stream of 10 to 20 bytes for most:
+//
+//   8   attributes (band, compander, scan lists)
+//   1   raw: the 16 channel bytes follow as they are, for anything the
+//       fields below can't hold exactly
+//   3   grid the frequencies are on, 12.5kHz down to 10Hz
+//   V   RX frequency above the bottom of its band, in grid steps
+//   2   offset direction
+//   1+3+V TX offset and its grid, if there is one
+//   3   modulation
+//   2+7 RX code type and code, the code only if there's a type
+//   2+7 TX code type and code
+//   8+8 flags (power, bandwidth, reverse, BCL, tail, PTT ID, DTMF decode)
+//   5   step
+//   4   scrambler
+//   4   name length in tokens, then 6 bits a token: a character, one of 16
+//       common words, or an escape and a raw byte
+//
+// V is a 5 bit bit count and that many bits. Decoding gives back the
+// channel bytes exactly and the name up to its terminator, so stock ->
+// compact -> stock only changes the padding after the name (to 0's, as
+// SETTINGS_SaveChannelName() writes it). No hardware in here, the PC
+// converter in utils/chan_pack.c uses it as is.
+
+#define CHCODEC_MAX_SIZE     40        // bytes, raw channel and 10 escaped name characters
+
+typedef struct {
+	uint8_t data[16];     // as at channel * 16
+	char    name[10];     // as at 0x0F50 + channel * 16, ends at 0x00 or 0xFF if shorter
+	uint8_t attributes;   // as at 0x0D60 + channel
+} CHCODEC_Stock_t;
+
+// returns the size of the record in bytes
+uint8_t CHCODEC_Encode(const CHCODEC_Stock_t *pStock, uint8_t *pOut);
+// false if the record doesn't make sense
+bool    CHCODEC_Decode(const uint8_t *pIn, uint8_t Size, CHCODEC_Stock_t *pStock);
+
+// a bank, the channels of one memory set in compact records:
+//
+//   0x0000  'C' 'B' version channel-count
+//   0x0004  index, a 16 bit offset from the start of the bank for each
+//           channel, 0xFFFF for an empty one, so any channel is found
+//           without reading the ones before it
+//   ...     records, each a length byte and the record
+
+#define CHBANK_MAGIC_0       'C'
+#define CHBANK_MAGIC_1       'B'
+#define CHBANK_VERSION       1
+#define CHBANK_CHANNELS      200
+#define CHBANK_INDEX         4
+#define CHBANK_RECORDS       (CHBANK_INDEX + (CHBANK_CHANNELS * 2))
+#define CHBANK_EMPTY         0xFFFF
+
+#endif
@@ -25,6 +25,39 @@
 uint16_t gBacklightCountdown_500ms = 0;
 bool backlightOn;
 
+#ifdef ENABLE_BACKLIGHT_FADE
+	// the brightness setting N is PWM 2^N - 1, the fade walks that curve in
+	// 1/16 steps so every step looks about the same to the eye
+
+	#define FADE_SHIFT         4
+	#define FADE_UP_STEP       16   // per 10ms, full brightness in 100ms
+	#define FADE_DOWN_STEP     2    // 800ms
+	#define FADE_NIGHT_STEP    1    // 1.6s
+	#define NIGHT_MAX          3    // brightness cap for the night profile
+	#define PWM_FLOOR          1    // lowest non-zero PWM, so a fade doesn't drop out early
+
+	bool gBacklightNight;
+
+	// 32768 * 2^(i/16)
+	static const uint16_t pow2_16[1 << FADE_SHIFT] = {
+		32768, 34219, 35734, 37316, 38968, 40693, 42495, 44376,
+		46341, 48393, 50535, 52773, 55109, 57549, 60097, 62757
+	};
+
+	static volatile uint8_t fadeLevel;
+	static volatile uint8_t fadeTarget;
+
+	static uint16_t LevelToPwm(const uint8_t level)
+	{
+		if (level == 0)
+			return 0;
+
+		const uint16_t pwm = (((uint32_t)pow2_16[level & ((1 << FADE_SHIFT) - 1)] << (level >> FADE_SHIFT)) >> 15) - 1;
+
+		return (pwm < PWM_FLOOR) ? PWM_FLOOR : pwm;
+	}
+#endif
+
 void BACKLIGHT_InitHardware()
 {
 	// 48MHz / 94 / 1024 ~ 500Hz
@@ -60,6 +93,11 @@ void BACKLIGHT_TurnOn(void)
 	}
 
 	backlightOn = true;
+#ifdef ENABLE_BACKLIGHT_FADE
+	if (gBacklightNight && gEeprom.BACKLIGHT_MAX > NIGHT_MAX)
+		BACKLIGHT_SetBrightness(NIGHT_MAX);
+	else
+#endif
 	BACKLIGHT_SetBrightness(gEeprom.BACKLIGHT_MAX);
 
 	switch (gEeprom.BACKLIGHT_TIME) {
@@ -89,11 +127,16 @@ void BACKLIGHT_TurnOff()
 		tmp = gEeprom.BACKLIGHT_MIN;
 	else
 		tmp = 0;
-
-	BACKLIGHT_SetBrightness(tmp);
 #else
-	BACKLIGHT_SetBrightness(gEeprom.BACKLIGHT_MIN);
+	register uint8_t tmp = gEeprom.BACKLIGHT_MIN;
+#endif
+
+#ifdef ENABLE_BACKLIGHT_FADE
+	if (gBacklightNight && tmp > NIGHT_MAX)
+		tmp = NIGHT_MAX;
 #endif
+
+	BACKLIGHT_SetBrightness(tmp);
 	gBacklightCountdown_500ms = 0;
 	backlightOn = false;
 }
@@ -108,11 +151,37 @@ static uint8_t currentBrightness;
 void BACKLIGHT_SetBrightness(uint8_t brigtness)
 {
 	currentBrightness = brigtness;
+#ifdef ENABLE_BACKLIGHT_FADE
+	fadeTarget = brigtness << FADE_SHIFT;   // BACKLIGHT_FadeTick() takes it from here
+#else
 	PWM_PLUS0_CH0_COMP = (1 << brigtness) - 1;
 	//PWM_PLUS0_SWLOAD = 1;
+#endif
 }
 
 uint8_t BACKLIGHT_GetBrightness(void)
 {
 	return currentBrightness;
-}
\ No newline at end of file
+}
+
+#ifdef ENABLE_BACKLIGHT_FADE
+void BACKLIGHT_FadeTick(void)
+{
+	const uint8_t target = fadeTarget;
+	uint8_t       level  = fadeLevel;
+
+	if (level == target)
+		return;
+
+	if (level < target) {
+		level = (target - level > FADE_UP_STEP) ? level + FADE_UP_STEP : target;
+	}
+	else {
+		const uint8_t step = gBacklightNight ? FADE_NIGHT_STEP : FADE_DOWN_STEP;
+		level = (level - target > step) ? level - step : target;
+	}
+
+	fadeLevel          = level;
+	PWM_PLUS0_CH0_COMP = LevelToPwm(level);
+}
+#endif
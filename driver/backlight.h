@@ -23,6 +23,11 @@
 extern uint16_t gBacklightCountdown_500ms;
 extern uint8_t gBacklightBrightness;
 
+#ifdef ENABLE_BACKLIGHT_FADE
+// night profile, dimmer and slower, toggled with a side key
+extern bool gBacklightNight;
+#endif
+
 #ifdef ENABLE_BLMIN_TMP_OFF
 typedef enum {
     BLMIN_STAT_ON,
@@ -38,4 +43,9 @@ bool BACKLIGHT_IsOn();
 void BACKLIGHT_SetBrightness(uint8_t brigtness);
 uint8_t BACKLIGHT_GetBrightness(void);
 
+#ifdef ENABLE_BACKLIGHT_FADE
+// from SystickHandler(), moves the PWM a step towards the set brightness
+void BACKLIGHT_FadeTick(void);
+#endif
+
 #endif
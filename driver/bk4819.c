@@ -558,7 +558,7 @@ void BK4819_EnableVox(uint16_t VoxEnableThreshold, uint16_t VoxDisableThreshold)
 	BK4819_WriteRegister(BK4819_REG_31, REG_31_Value | (1u << 2));    // VOX Enable
 }
 
-void BK4819_SetFilterBandwidth(const BK4819_FilterBandwidth_t Bandwidth, const bool weak_no_different)
+uint16_t BK4819_GetFilterBandwidthReg(const BK4819_FilterBandwidth_t Bandwidth, const bool weak_no_different)
 {
 	// REG_43
 	// <15>    0 ???
@@ -660,10 +660,15 @@ void BK4819_SetFilterBandwidth(const BK4819_FilterBandwidth_t Bandwidth, const b
 			break;
 	}
 
-	BK4819_WriteRegister(BK4819_REG_43, val);
+	return val;
 }
 
-void BK4819_SetupPowerAmplifier(const uint8_t bias, const uint32_t frequency)
+void BK4819_SetFilterBandwidth(const BK4819_FilterBandwidth_t Bandwidth, const bool weak_no_different)
+{
+	BK4819_WriteRegister(BK4819_REG_43, BK4819_GetFilterBandwidthReg(Bandwidth, weak_no_different));
+}
+
+uint16_t BK4819_GetPowerAmplifierReg(const uint8_t bias, const uint32_t frequency)
 {
 	// REG_36 <15:8> 0 PA Bias output 0 ~ 3.2V
 	//               255 = 3.2V
@@ -684,7 +689,12 @@ void BK4819_SetupPowerAmplifier(const uint8_t bias, const uint32_t frequency)
 	//                                  280MHz       g1=1  g2=0 (-14.9dBm),  g1=4  g2=2 (0.13dBm)
 	const uint8_t gain   = (frequency < 28000000) ? (1u << 3) | (0u << 0) : (4u << 3) | (2u << 0);
 	const uint8_t enable = 1;
-	BK4819_WriteRegister(BK4819_REG_36, (bias << 8) | (enable << 7) | (gain << 0));
+	return (bias << 8) | (enable << 7) | (gain << 0);
+}
+
+void BK4819_SetupPowerAmplifier(const uint8_t bias, const uint32_t frequency)
+{
+	BK4819_WriteRegister(BK4819_REG_36, BK4819_GetPowerAmplifierReg(bias, frequency));
 }
 
 void BK4819_SetFrequency(uint32_t Frequency)
@@ -989,7 +999,9 @@ void BK4819_PlayTone(uint16_t Frequency, bool bTuningGainSwitch)
 }
 
 // level 0 ~ 127
-void BK4819_PlaySingleTone(const unsigned int tone_Hz, const unsigned int delay, const unsigned int level, const bool play_speaker)
+// sets up the TX link for a single tone, it wants ~50ms to settle before the
+// tone is switched on with BK4819_SetTone1Frequency() and BK4819_ExitTxMute()
+void BK4819_StartSingleTone(const unsigned int level, const bool play_speaker)
 {
 	BK4819_EnterTxMute();
 
@@ -1005,12 +1017,15 @@ void BK4819_PlaySingleTone(const unsigned int tone_Hz, const unsigned int delay,
 	BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | ((level & 0x7f) << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
 
 	BK4819_EnableTXLink();
-	SYSTEM_DelayMs(50);
+}
 
+void BK4819_SetTone1Frequency(const unsigned int tone_Hz)
+{
 	BK4819_WriteRegister(BK4819_REG_71, scale_freq(tone_Hz));
+}
 
-	BK4819_ExitTxMute();
-	SYSTEM_DelayMs(delay);
+void BK4819_StopSingleTone(const bool play_speaker, const bool bKeepMute)
+{
 	BK4819_EnterTxMute();
 
 	if (play_speaker)
@@ -1020,8 +1035,9 @@ void BK4819_PlaySingleTone(const unsigned int tone_Hz, const unsigned int delay,
 	}
 
 	BK4819_WriteRegister(BK4819_REG_70, 0x0000);
-	BK4819_WriteRegister(BK4819_REG_30, 0xC1FE);
-	BK4819_ExitTxMute();
+	BK4819_WriteRegister(BK4819_REG_30, 0xC1FE);   // 1 1 0000 0 1 1111 1 1 1 0
+	if (!bKeepMute)
+		BK4819_ExitTxMute();
 }
 
 void BK4819_EnterTxMute(void)
@@ -1057,15 +1073,15 @@ void BK4819_TurnsOffTones_TurnsOnRX(void)
 		BK4819_REG_30_ENABLE_RX_DSP);
 }
 
-#ifdef ENABLE_AIRCOPY
-	void BK4819_SetupAircopy(void)
+#ifdef ENABLE_FSK_PACKETS
+	void BK4819_SetupFSK(void)
 	{
 		BK4819_WriteRegister(BK4819_REG_70, 0x00E0);    // Enable Tone2, tuning gain 48
 		BK4819_WriteRegister(BK4819_REG_72, 0x3065);    // Tone2 baudrate 1200
 		BK4819_WriteRegister(BK4819_REG_58, 0x00C1);    // FSK Enable, FSK 1.2K RX Bandwidth, Preamble 0xAA or 0x55, RX Gain 0, RX Mode
 		                                                // (FSK1.2K, FSK2.4K Rx and NOAA SAME Rx), TX Mode FSK 1.2K and FSK 2.4K Tx
 		BK4819_WriteRegister(BK4819_REG_5C, 0x5665);    // Enable CRC among other things we don't know yet
-		BK4819_WriteRegister(BK4819_REG_5D, 0x4700);    // FSK Data Length 72 Bytes (0xabcd + 2 byte length + 64 byte payload + 2 byte CRC + 0xdcba)
+		                                                // (the original firmware checks it on aircopy packets)
 	}
 #endif
 
@@ -1276,31 +1292,6 @@ void BK4819_PlayDTMF(char Code)
 	}
 }
 
-void BK4819_PlayDTMFString(const char *pString, bool bDelayFirst, uint16_t FirstCodePersistTime, uint16_t HashCodePersistTime, uint16_t CodePersistTime, uint16_t CodeInternalTime)
-{
-	unsigned int i;
-
-	if (pString == NULL)
-		return;
-
-	for (i = 0; pString[i]; i++)
-	{
-		uint16_t Delay;
-		BK4819_PlayDTMF(pString[i]);
-		BK4819_ExitTxMute();
-		if (bDelayFirst && i == 0)
-			Delay = FirstCodePersistTime;
-		else
-		if (pString[i] == '*' || pString[i] == '#')
-			Delay = HashCodePersistTime;
-		else
-			Delay = CodePersistTime;
-		SYSTEM_DelayMs(Delay);
-		BK4819_EnterTxMute();
-		SYSTEM_DelayMs(CodeInternalTime);
-	}
-}
-
 void BK4819_TransmitTone(bool bLocalLoopback, uint32_t Frequency)
 {
 	BK4819_EnterTxMute();
@@ -1401,13 +1392,10 @@ void BK4819_PlayCDCSSTail(void)
 	BK4819_WriteRegister(BK4819_REG_51, 0x804A); // 1 0 0 0 0 0 0 0  0  1001010
 }
 
-void BK4819_PlayCTCSSTail(void)
+// Tail = 1 to 3 for a 120/180/240° phase shift, 4 for the 55Hz tone
+void BK4819_PlayCTCSSTail(const uint8_t Tail)
 {
-	#ifdef ENABLE_CTCSS_TAIL_PHASE_SHIFT
-		BK4819_GenTail(2);       // 180° phase shift
-	#else
-		BK4819_GenTail(4);       // 55Hz tone freq
-	#endif
+	BK4819_GenTail(Tail);
 
 	// REG_51
 	//
@@ -1638,42 +1626,54 @@ uint8_t BK4819_GetCTCType(void)
 	return (BK4819_ReadRegister(BK4819_REG_0C) >> 10) & 3u;
 }
 
-void BK4819_SendFSKData(uint16_t *pData)
+#ifdef ENABLE_FSK_PACKETS
+// FSK data length in REG_5D <15:8> is in bytes, minus one
+static void SetFSKLength(const unsigned int Words)
 {
-	unsigned int i;
-	uint8_t Timeout = 200;
-
-	SYSTEM_DelayMs(20);
+	BK4819_WriteRegister(BK4819_REG_5D, ((Words * 2) - 1) << 8);
+}
 
+// loads a packet into the TX FIFO (36 words at most, the size of the original
+// aircopy packet, nobody knows how deep the FIFO really is) and arms the TX finished
+// interrupt, start it with BK4819_StartFSKTransmit() ~20ms later
+void BK4819_LoadFSKTxData(const uint16_t *pData, const unsigned int Words)
+{
 	BK4819_WriteRegister(BK4819_REG_3F, BK4819_REG_3F_FSK_TX_FINISHED);
+	SetFSKLength(Words);
+
+	// Clear TX FIFO
 	BK4819_WriteRegister(BK4819_REG_59, 0x8068);
 	BK4819_WriteRegister(BK4819_REG_59, 0x0068);
 
-	for (i = 0; i < 36; i++)
+	for (unsigned int i = 0; i < Words; i++)
 		BK4819_WriteRegister(BK4819_REG_5F, pData[i]);
+}
 
-	SYSTEM_DelayMs(20);
-
+void BK4819_StartFSKTransmit(void)
+{
+	// Enable FSK TX
+	// Enable FSK Scramble
+	// FSK Preamble Length 7 bytes
+	// FSK SyncLength Selection
 	BK4819_WriteRegister(BK4819_REG_59, 0x2868);
-
-	while (Timeout-- && (BK4819_ReadRegister(BK4819_REG_0C) & 1u) == 0)
-		SYSTEM_DelayMs(5);
-
-	BK4819_WriteRegister(BK4819_REG_02, 0);
-
-	SYSTEM_DelayMs(20);
-
-	BK4819_ResetFSK();
 }
 
-void BK4819_PrepareFSKReceive(void)
+// turns the receiver on and listens for packets of up to 'MaxWords'
+void BK4819_PrepareFSKReceive(const unsigned int MaxWords)
 {
 	BK4819_ResetFSK();
 	BK4819_WriteRegister(BK4819_REG_02, 0);
 	BK4819_WriteRegister(BK4819_REG_3F, 0);
 	BK4819_RX_TurnOn();
+	SetFSKLength(MaxWords);
 	BK4819_WriteRegister(BK4819_REG_3F, 0 | BK4819_REG_3F_FSK_RX_FINISHED | BK4819_REG_3F_FSK_FIFO_ALMOST_FULL);
+	BK4819_RestartFSKReceive();
+}
 
+// drops whatever is in the RX FIFO and waits for the next sync word,
+// without the settling delay BK4819_PrepareFSKReceive() has
+void BK4819_RestartFSKReceive(void)
+{
 	// Clear RX FIFO
 	// FSK Preamble Length 7 bytes
 	// FSK SyncLength Selection
@@ -1685,45 +1685,11 @@ void BK4819_PrepareFSKReceive(void)
 	// FSK SyncLength Selection
 	BK4819_WriteRegister(BK4819_REG_59, 0x3068);
 }
+#endif
 
-static void BK4819_PlayRogerNormal(void)
-{
-	#if 0
-		const uint32_t tone1_Hz = 500;
-		const uint32_t tone2_Hz = 700;
-	#else
-		// motorola type
-		const uint32_t tone1_Hz = 1540;
-		const uint32_t tone2_Hz = 1310;
-	#endif
-
-
-	BK4819_EnterTxMute();
-	BK4819_SetAF(BK4819_AF_MUTE);
-
-	BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | (66u << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
-
-	BK4819_EnableTXLink();
-	SYSTEM_DelayMs(50);
-
-	BK4819_WriteRegister(BK4819_REG_71, scale_freq(tone1_Hz));
-
-	BK4819_ExitTxMute();
-	SYSTEM_DelayMs(80);
-	BK4819_EnterTxMute();
-
-	BK4819_WriteRegister(BK4819_REG_71, scale_freq(tone2_Hz));
-
-	BK4819_ExitTxMute();
-	SYSTEM_DelayMs(80);
-	BK4819_EnterTxMute();
-
-	BK4819_WriteRegister(BK4819_REG_70, 0x0000);
-	BK4819_WriteRegister(BK4819_REG_30, 0xC1FE);   // 1 1 0000 0 1 1111 1 1 1 0
-}
-
-
-void BK4819_PlayRogerMDC(void)
+// MDC1200 roger, load it with BK4819_StartRogerMDC(), send it ~20ms later
+// with BK4819_SendRogerMDC() and BK4819_StopRogerMDC() once it's out (~180ms)
+void BK4819_StartRogerMDC(void)
 {
 	struct reg_value {
 		BK4819_REGISTER_t reg;
@@ -1757,29 +1723,22 @@ void BK4819_PlayRogerMDC(void)
 	for (unsigned int i = 0; i < ARRAY_SIZE(FSK_RogerTable); i++) {
 		BK4819_WriteRegister(BK4819_REG_5F, FSK_RogerTable[i]);
 	}
+}
 
-	SYSTEM_DelayMs(20);
-
+void BK4819_SendRogerMDC(void)
+{
 	// 4 sync bytes, 6 byte preamble, Enable FSK TX
 	BK4819_WriteRegister(BK4819_REG_59, 0x0868);
+}
 
-	SYSTEM_DelayMs(180);
-
+void BK4819_StopRogerMDC(void)
+{
 	// Stop FSK TX, reset Tone-2, disable FSK
 	BK4819_WriteRegister(BK4819_REG_59, 0x0068);
 	BK4819_WriteRegister(BK4819_REG_70, 0x0000);
 	BK4819_WriteRegister(BK4819_REG_58, 0x0000);
 }
 
-void BK4819_PlayRoger(void)
-{
-	if (gEeprom.ROGER == ROGER_MODE_ROGER) {
-		BK4819_PlayRogerNormal();
-	} else if (gEeprom.ROGER == ROGER_MODE_MDC) {
-		BK4819_PlayRogerMDC();
-	}
-}
-
 void BK4819_Enable_AfDac_DiscMode_TxDsp(void)
 {
 	BK4819_WriteRegister(BK4819_REG_30, 0x0000);
@@ -81,7 +81,10 @@ void     BK4819_SetCDCSSCodeWord(uint32_t CodeWord);
 void     BK4819_SetCTCSSFrequency(uint32_t BaudRate);
 void     BK4819_SetTailDetection(const uint32_t freq_10Hz);
 void     BK4819_EnableVox(uint16_t Vox1Threshold, uint16_t Vox0Threshold);
+// the Get..Reg() ones give the register value without writing it, for RADIO_SetTxParameters()
+uint16_t BK4819_GetFilterBandwidthReg(const BK4819_FilterBandwidth_t Bandwidth, const bool weak_no_different);
 void     BK4819_SetFilterBandwidth(const BK4819_FilterBandwidth_t Bandwidth, const bool weak_no_different);
+uint16_t BK4819_GetPowerAmplifierReg(const uint8_t bias, const uint32_t frequency);
 void     BK4819_SetupPowerAmplifier(const uint8_t bias, const uint32_t frequency);
 void     BK4819_SetFrequency(uint32_t Frequency);
 void     BK4819_SetupSquelch(
@@ -105,13 +108,15 @@ void     BK4819_DisableVox(void);
 void     BK4819_DisableDTMF(void);
 void     BK4819_EnableDTMF(void);
 void     BK4819_PlayTone(uint16_t Frequency, bool bTuningGainSwitch);
-void     BK4819_PlaySingleTone(const unsigned int tone_Hz, const unsigned int delay, const unsigned int level, const bool play_speaker);
+void     BK4819_StartSingleTone(const unsigned int level, const bool play_speaker);
+void     BK4819_SetTone1Frequency(const unsigned int tone_Hz);
+void     BK4819_StopSingleTone(const bool play_speaker, const bool bKeepMute);
 void     BK4819_EnterTxMute(void);
 void     BK4819_ExitTxMute(void);
 void     BK4819_Sleep(void);
 void     BK4819_TurnsOffTones_TurnsOnRX(void);
-#ifdef ENABLE_AIRCOPY
-	void     BK4819_SetupAircopy(void);
+#ifdef ENABLE_FSK_PACKETS
+	void     BK4819_SetupFSK(void);
 #endif
 void     BK4819_ResetFSK(void);
 void     BK4819_Idle(void);
@@ -127,13 +132,12 @@ void     BK4819_ExitDTMF_TX(bool bKeep);
 void     BK4819_EnableTXLink(void);
 
 void     BK4819_PlayDTMF(char Code);
-void     BK4819_PlayDTMFString(const char *pString, bool bDelayFirst, uint16_t FirstCodePersistTime, uint16_t HashCodePersistTime, uint16_t CodePersistTime, uint16_t CodeInternalTime);
 
 void     BK4819_TransmitTone(bool bLocalLoopback, uint32_t Frequency);
 
 void     BK4819_GenTail(uint8_t Tail);
 void     BK4819_PlayCDCSSTail(void);
-void     BK4819_PlayCTCSSTail(void);
+void     BK4819_PlayCTCSSTail(const uint8_t Tail);
 
 uint16_t BK4819_GetRSSI(void);
 int8_t   BK4819_GetRxGain_dB(void);
@@ -159,10 +163,16 @@ uint8_t  BK4819_GetCDCSSCodeType(void);
 uint8_t  BK4819_GetCTCShift(void);
 uint8_t  BK4819_GetCTCType(void);
 
-void     BK4819_SendFSKData(uint16_t *pData);
-void     BK4819_PrepareFSKReceive(void);
+#ifdef ENABLE_FSK_PACKETS
+	void     BK4819_LoadFSKTxData(const uint16_t *pData, const unsigned int Words);
+	void     BK4819_StartFSKTransmit(void);
+	void     BK4819_PrepareFSKReceive(const unsigned int MaxWords);
+	void     BK4819_RestartFSKReceive(void);
+#endif
 
-void     BK4819_PlayRoger(void);
+void     BK4819_StartRogerMDC(void);
+void     BK4819_SendRogerMDC(void);
+void     BK4819_StopRogerMDC(void);
 
 void     BK4819_Enable_AfDac_DiscMode_TxDsp(void);
 
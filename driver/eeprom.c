@@ -20,8 +20,38 @@
 #include "driver/eeprom.h"
 #include "driver/i2c.h"
 #include "driver/system.h"
+#include "misc.h"
 
-void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
+#if EEPROM_SIZE_KB < 64
+	#define OUT_OF_RANGE(Address)   ((Address) >= EEPROM_SIZE_KB * 1024u)
+#else
+	#define OUT_OF_RANGE(Address)   false   // the whole 16 bit address range
+#endif
+
+#ifdef ENABLE_DEFERRED_SAVES
+	// 8 byte blocks waiting to be written, oldest first
+	static struct {
+		uint16_t Address;
+		uint8_t  Data[8];
+	} deferred[EEPROM_DEFERRED_BLOCKS];
+	static uint8_t deferredCount;
+
+	static void DropDeferred(const unsigned int i)
+	{
+		deferredCount--;
+		memmove(&deferred[i], &deferred[i + 1], (deferredCount - i) * sizeof(deferred[0]));
+	}
+
+	static int FindDeferred(const uint16_t Address)
+	{
+		for (unsigned int i = 0; i < deferredCount; i++)
+			if (deferred[i].Address == Address)
+				return i;
+		return -1;
+	}
+#endif
+
+static void ReadDevice(uint16_t Address, void *pBuffer, uint8_t Size)
 {
 	I2C_Start();
 
@@ -39,15 +69,27 @@ void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
 	I2C_Stop();
 }
 
-void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
+void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
 {
-	if (pBuffer == NULL || Address >= 0x2000)
-		return;
+	ReadDevice(Address, pBuffer, Size);
 
+#ifdef ENABLE_DEFERRED_SAVES
+	// what's waiting to be written reads back as if it had been
+	for (unsigned int i = 0; i < deferredCount; i++) {
+		const int start = (deferred[i].Address > Address) ? deferred[i].Address : Address;
+		const int end   = (deferred[i].Address + 8 < Address + Size) ? deferred[i].Address + 8 : Address + Size;
+		if (start < end)
+			memcpy((uint8_t *)pBuffer + (start - Address), &deferred[i].Data[start - deferred[i].Address], end - start);
+	}
+#endif
+}
 
-	uint8_t buffer[8];
-	EEPROM_ReadBuffer(Address, buffer, 8);
-	if (memcmp(pBuffer, buffer, 8) == 0) {
+// one write cycle, Size bytes that mustn't cross a 32 byte page
+static void WriteDevice(uint16_t Address, const void *pBuffer, uint8_t Size)
+{
+	uint8_t buffer[16];
+	ReadDevice(Address, buffer, Size);
+	if (memcmp(pBuffer, buffer, Size) == 0) {
 		return;
 	}
 
@@ -55,9 +97,89 @@ void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
 	I2C_Write(0xA0);
 	I2C_Write((Address >> 8) & 0xFF);
 	I2C_Write((Address >> 0) & 0xFF);
-	I2C_WriteBuffer(pBuffer, 8);
+	I2C_WriteBuffer(pBuffer, Size);
 	I2C_Stop();
 
 	// give the EEPROM time to burn the data in (apparently takes 5ms)
 	SYSTEM_DelayMs(8);
 }
+
+void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
+{
+	if (pBuffer == NULL || OUT_OF_RANGE(Address))
+		return;
+
+#ifdef ENABLE_DEFERRED_SAVES
+	// this write supersedes one waiting for the same block
+	const int i = FindDeferred(Address);
+	if (i >= 0)
+		DropDeferred(i);
+#endif
+
+	WriteDevice(Address, pBuffer, 8);
+}
+
+void EEPROM_WriteBuffer16(uint16_t Address, const void *pBuffer)
+{
+	if (pBuffer == NULL || OUT_OF_RANGE(Address) || (Address & 15u) != 0)
+		return;
+
+#ifdef ENABLE_DEFERRED_SAVES
+	for (unsigned int k = 0; k < 2; k++) {
+		const int i = FindDeferred(Address + (k * 8));
+		if (i >= 0)
+			DropDeferred(i);
+	}
+#endif
+
+	WriteDevice(Address, pBuffer, 16);
+}
+
+#ifdef ENABLE_DEFERRED_SAVES
+
+void EEPROM_WriteBufferDeferred(uint16_t Address, const void *pBuffer)
+{
+	if (pBuffer == NULL || OUT_OF_RANGE(Address))
+		return;
+
+	int i = FindDeferred(Address);
+	if (i < 0) {
+		if (deferredCount == EEPROM_DEFERRED_BLOCKS)
+			EEPROM_Flush();
+		i = deferredCount++;
+		deferred[i].Address = Address;
+	}
+
+	memcpy(deferred[i].Data, pBuffer, 8);
+
+	// written once there's been no deferred write for a while
+	gEepromWriteCountdown_10ms = eeprom_write_delay_10ms;
+}
+
+bool EEPROM_IsDeferred(uint16_t Address)
+{
+	return FindDeferred(Address) >= 0;
+}
+
+void EEPROM_Flush(void)
+{
+	// in the order they came, EEPROM_WriteBuffer() takes each off the list,
+	// both halves of a 16 byte record go out in the one write cycle
+	while (deferredCount > 0) {
+		const int pair = ((deferred[0].Address & 15u) == 0) ? FindDeferred(deferred[0].Address + 8) : -1;
+
+		if (pair > 0) {
+			uint8_t Data[16];
+			memcpy(Data + 0, deferred[0].Data, 8);
+			memcpy(Data + 8, deferred[pair].Data, 8);
+			EEPROM_WriteBuffer16(deferred[0].Address, Data);
+		}
+		else {
+			uint8_t Data[8];
+			memcpy(Data, deferred[0].Data, sizeof(Data));
+			EEPROM_WriteBuffer(deferred[0].Address, Data);
+		}
+	}
+}
+
+#endif
@@ -17,10 +17,33 @@
 #ifndef DRIVER_EEPROM_H
 #define DRIVER_EEPROM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+// the stock part is a 24C64, a 24C128 .. 24C512 in its place is addressed
+// the same way and just goes on past 0x2000
+#ifndef EEPROM_SIZE_KB
+	#define EEPROM_SIZE_KB    8
+#endif
+
 void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size);
 void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer);
+// 16 bytes in a single write cycle, Address on a 16 byte boundary so it
+// stays inside one of the 24C64's 32 byte pages
+void EEPROM_WriteBuffer16(uint16_t Address, const void *pBuffer);
+
+#ifdef ENABLE_DEFERRED_SAVES
+	// write-back for the blocks that get saved over and over (VFO indices,
+	// the VFO frequency while it's being tuned): held in RAM until
+	// EEPROM_Flush(), which the main loop calls eeprom_write_delay_10ms
+	// after the last of them. Reads see them straight away, and a normal
+	// write to the same block replaces it
+	#define EEPROM_DEFERRED_BLOCKS    6
+
+	void EEPROM_WriteBufferDeferred(uint16_t Address, const void *pBuffer);
+	bool EEPROM_IsDeferred(uint16_t Address);
+	void EEPROM_Flush(void);
+#endif
 
 #endif
 
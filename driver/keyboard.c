@@ -22,10 +22,7 @@
 #include "driver/i2c.h"
 #include "misc.h"
 
-KEY_Code_t gKeyReading0     = KEY_INVALID;
-KEY_Code_t gKeyReading1     = KEY_INVALID;
-uint16_t   gDebounceCounter = 0;
-bool       gWasFKeyPressed  = false;
+bool gWasFKeyPressed = false;
 
 static const struct {
 
@@ -92,6 +89,41 @@ static const struct {
 	}
 };
 
+#define ROWS_MASK    (1u << GPIOA_PIN_KEYBOARD_4 | 1u << GPIOA_PIN_KEYBOARD_5 | \
+                      1u << GPIOA_PIN_KEYBOARD_6 | 1u << GPIOA_PIN_KEYBOARD_7)
+#define COLUMNS_MASK (1u << GPIOA_PIN_KEYBOARD_0 | 1u << GPIOA_PIN_KEYBOARD_1 | \
+                      1u << GPIOA_PIN_KEYBOARD_2 | 1u << GPIOA_PIN_KEYBOARD_3)
+
+static void ReleaseRows(void)
+{
+	// Create I2C stop condition since we might have toggled I2C pins
+	// This leaves GPIOA_PIN_KEYBOARD_4 and GPIOA_PIN_KEYBOARD_5 high
+	I2C_Stop();
+
+	// Reset VOICE pins
+	GPIO_ClearBit(&GPIOA->DATA, GPIOA_PIN_KEYBOARD_6);
+	GPIO_SetBit(  &GPIOA->DATA, GPIOA_PIN_KEYBOARD_7);
+}
+
+bool KEYBOARD_AnyKeyDown(void)
+{
+	// all rows low at once, any key (side keys included, they go straight
+	// to ground) pulls its column down, two equal reads to beat the noise
+	GPIOA->DATA &= ~ROWS_MASK;
+
+	uint16_t reg = 0;
+	for (unsigned int i = 0, k = 0; i < 2 && k < 8; i++, k++) {
+		SYSTICK_DelayUs(1);
+		const uint16_t reg2 = GPIOA->DATA & COLUMNS_MASK;
+		i *= reg == reg2;
+		reg = reg2;
+	}
+
+	ReleaseRows();
+
+	return reg != COLUMNS_MASK;
+}
+
 KEY_Code_t KEYBOARD_Poll(void)
 {
 	KEY_Code_t Key = KEY_INVALID;
@@ -108,10 +140,7 @@ KEY_Code_t KEYBOARD_Poll(void)
 		unsigned int k;
 
 		// Set all high
-		GPIOA->DATA |=  1u << GPIOA_PIN_KEYBOARD_4 |
-						1u << GPIOA_PIN_KEYBOARD_5 |
-						1u << GPIOA_PIN_KEYBOARD_6 |
-						1u << GPIOA_PIN_KEYBOARD_7;
+		GPIOA->DATA |= ROWS_MASK;
 
 		// Clear the pin we are selecting
 		GPIOA->DATA &= keyboard[j].set_to_zero_mask;
@@ -141,13 +170,7 @@ KEY_Code_t KEYBOARD_Poll(void)
 			break;
 	}
 
-	// Create I2C stop condition since we might have toggled I2C pins
-	// This leaves GPIOA_PIN_KEYBOARD_4 and GPIOA_PIN_KEYBOARD_5 high
-	I2C_Stop();
-
-	// Reset VOICE pins
-	GPIO_ClearBit(&GPIOA->DATA, GPIOA_PIN_KEYBOARD_6);
-	GPIO_SetBit(  &GPIOA->DATA, GPIOA_PIN_KEYBOARD_7);
+	ReleaseRows();
 
 	return Key;
 }
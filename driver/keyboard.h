@@ -45,11 +45,10 @@ enum KEY_Code_e {
 };
 typedef enum KEY_Code_e KEY_Code_t;
 
-extern KEY_Code_t gKeyReading0;
-extern KEY_Code_t gKeyReading1;
-extern uint16_t   gDebounceCounter;
-extern bool       gWasFKeyPressed;
+extern bool gWasFKeyPressed;
 
+// cheap check with all rows driven at once, KEYBOARD_Poll() finds out which
+bool       KEYBOARD_AnyKeyDown(void);
 KEY_Code_t KEYBOARD_Poll(void);
 
 #endif
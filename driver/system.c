@@ -14,6 +14,7 @@
  *     limitations under the License.
  */
 
+#include "ARMCM0.h"
 #include "../bsp/dp32g030/pmu.h"
 #include "../bsp/dp32g030/syscon.h"
 #include "system.h"
@@ -24,6 +25,34 @@ void SYSTEM_DelayMs(uint32_t Delay)
 	SYSTICK_DelayUs(Delay * 1000);
 }
 
+// stop the core (WFI) until the next interrupt, normally the 10ms SysTick,
+// unless *pPending got set already. Peripherals, DMA and SysTick keep going.
+// Returns the SysTick clocks spent asleep
+uint32_t SYSTEM_Sleep(volatile bool *pPending)
+{
+	uint32_t slept = 0;
+
+	// masked so the tick can't sneak in between the check and the WFI,
+	// a pending interrupt still wakes the core up
+	__disable_irq();
+
+	if (!*pPending) {
+		const uint32_t start = SysTick->VAL;
+
+		__WFI();
+
+		const uint32_t end = SysTick->VAL;
+		if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+			slept = start + (SysTick->LOAD + 1) - end;   // counter reloaded
+		else
+			slept = start - end;
+	}
+
+	__enable_irq();
+
+	return slept;
+}
+
 void SYSTEM_ConfigureClocks(void)
 {
 	// Set source clock from external crystal
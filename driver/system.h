@@ -17,10 +17,12 @@
 #ifndef DRIVER_SYSTEM_H
 #define DRIVER_SYSTEM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
-void SYSTEM_DelayMs(uint32_t Delay);
-void SYSTEM_ConfigureClocks(void);
+void     SYSTEM_DelayMs(uint32_t Delay);
+void     SYSTEM_ConfigureClocks(void);
+uint32_t SYSTEM_Sleep(volatile bool *pPending);
 
 #endif
 
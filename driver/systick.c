@@ -47,3 +47,16 @@ void SYSTICK_DelayUs(uint32_t Delay)
 		Previous = Current;
 	} while (elapsed_ticks < ticks);
 }
+
+uint32_t SYSTICK_GetUs(void)
+{
+	uint32_t Ticks;
+	uint32_t Current;
+
+	do {	// again if the 10ms interrupt came in between
+		Ticks   = gGlobalSysTickCounter;
+		Current = SysTick->VAL;
+	} while (Ticks != gGlobalSysTickCounter);
+
+	return (Ticks * 10000) + (SysTick->LOAD - Current) / gTickMultiplier;
+}
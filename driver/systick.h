@@ -21,6 +21,8 @@
 
 void SYSTICK_Init(void);
 void SYSTICK_DelayUs(uint32_t Delay);
+// us since boot, wraps every 71 minutes
+uint32_t SYSTICK_GetUs(void);
 
 #endif
 
@@ -124,25 +124,56 @@ FREQUENCY_Band_t FREQUENCY_GetBand(uint32_t Frequency)
 	return BAND1_50MHz;
 }
 
-uint8_t FREQUENCY_CalculateOutputPower(uint8_t TxpLow, uint8_t TxpMid, uint8_t TxpHigh, int32_t LowerLimit, int32_t Middle, int32_t UpperLimit, int32_t Frequency)
+// the TX power calibration, per band and power setting, with the slopes either
+// side of the middle of the band worked out when it's loaded, so a scan hop
+// gets its power from a multiply and a shift rather than a 32 bit divide
+static struct {
+	uint8_t low;
+	uint8_t mid;
+	uint8_t high;
+	int32_t slope[2];    // calibration steps per 2.56kHz, << 20
+} txpCalib[BAND_N_ELEM][OUTPUT_POWER_HIGH + 1];
+
+void FREQUENCY_SetOutputPowerCalibration(const FREQUENCY_Band_t Band, const uint8_t Power, const uint8_t Txp[3])
 {
-	if (Frequency <= LowerLimit)
-		return TxpLow;
+	const uint32_t lower  = frequencyBandTable[Band].lower;
+	const uint32_t upper  = frequencyBandTable[Band].upper;
+	const uint32_t middle = (lower + upper) / 2;
 
-	if (UpperLimit <= Frequency)
-		return TxpHigh;
+	if (Power > OUTPUT_POWER_HIGH)
+		return;
 
-	if (Frequency <= Middle)
-	{
-		TxpMid += ((TxpMid - TxpLow) * (Frequency - LowerLimit)) / (Middle - LowerLimit);
-		return TxpMid;
-	}
-
-	TxpMid += ((TxpHigh - TxpMid) * (Frequency - Middle)) / (UpperLimit - Middle);
+	txpCalib[Band][Power].low  = Txp[0];
+	txpCalib[Band][Power].mid  = Txp[1];
+	txpCalib[Band][Power].high = Txp[2];
 
-	return TxpMid;
+	// the bottom half of the band goes up from the middle value by the low to
+	// middle difference, as the original firmware has it
+	txpCalib[Band][Power].slope[0] = ((int32_t)(Txp[1] - Txp[0]) * (1 << 20)) / (int32_t)((middle - lower) >> 8);
+	txpCalib[Band][Power].slope[1] = ((int32_t)(Txp[2] - Txp[1]) * (1 << 20)) / (int32_t)((upper - middle) >> 8);
 }
 
+uint8_t FREQUENCY_GetOutputPower(const FREQUENCY_Band_t Band, const uint8_t Power, const uint32_t Frequency)
+{
+	if (Band < 0 || Band >= BAND_N_ELEM || Power > OUTPUT_POWER_HIGH)
+		return 0;
+
+	const uint32_t lower  = frequencyBandTable[Band].lower;
+	const uint32_t upper  = frequencyBandTable[Band].upper;
+	const uint32_t middle = (lower + upper) / 2;
+
+	if (Frequency <= lower)
+		return txpCalib[Band][Power].low;
+
+	if (upper <= Frequency)
+		return txpCalib[Band][Power].high;
+
+	const bool    top   = Frequency > middle;
+	const int32_t steps = (int32_t)((Frequency - (top ? middle : lower)) >> 8) * txpCalib[Band][Power].slope[top];
+
+	// toward zero like the divide was
+	return txpCalib[Band][Power].mid + ((steps < 0) ? -(-steps >> 20) : (steps >> 20));
+}
 
 uint32_t FREQUENCY_RoundToStep(uint32_t freq, uint16_t step)
 {
@@ -81,7 +81,8 @@ extern const uint16_t gStepFrequencyTable[];
 #endif
 
 FREQUENCY_Band_t FREQUENCY_GetBand(uint32_t Frequency);
-uint8_t          FREQUENCY_CalculateOutputPower(uint8_t TxpLow, uint8_t TxpMid, uint8_t TxpHigh, int32_t LowerLimit, int32_t Middle, int32_t UpperLimit, int32_t Frequency);
+void             FREQUENCY_SetOutputPowerCalibration(FREQUENCY_Band_t Band, uint8_t Power, const uint8_t Txp[3]);
+uint8_t          FREQUENCY_GetOutputPower(FREQUENCY_Band_t Band, uint8_t Power, uint32_t Frequency);
 uint32_t 		 FREQUENCY_RoundToStep(uint32_t freq, uint16_t step);
 
 STEP_Setting_t   FREQUENCY_GetStepIdxFromSortedIdx(uint8_t sortedIdx);
@@ -35,8 +35,10 @@
 #include "functions.h"
 #include "helper/battery.h"
 #include "misc.h"
+#include "power_save.h"
 #include "radio.h"
 #include "settings.h"
+#include "tail.h"
 #include "ui/status.h"
 #include "ui/ui.h"
 
@@ -59,6 +61,7 @@ void FUNCTION_Init(void)
 
 	gFlagTailToneEliminationComplete   = false;
 	gTailToneEliminationCountdown_10ms = 0;
+	TAIL_RxReset();
 	gFoundCTCSS                        = false;
 	gFoundCDCSS                        = false;
 	gFoundCTCSSCountdown_10ms          = 0;
@@ -118,7 +121,7 @@ void FUNCTION_Foreground(const FUNCTION_Type_t PreviousFunction)
 }
 
 void FUNCTION_PowerSave() {
-	gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
+	gPowerSave_10ms = POWERSAVE_NextSleep_10ms(gEeprom.BATTERY_SAVE);
 	gPowerSaveCountdownExpired = false;
 
 	gRxIdleMode = true;
@@ -136,8 +139,20 @@ void FUNCTION_PowerSave() {
 		GUI_SelectNextDisplay(DISPLAY_MAIN);
 }
 
+static void SetupScramble(uint16_t unused)
+{
+	(void)unused;
+
+	if (gCurrentVfo->SCRAMBLING_TYPE > 0 && gSetting_ScrambleEnable)
+		BK4819_EnableScramble(gCurrentVfo->SCRAMBLING_TYPE - 1);
+	else
+		BK4819_DisableScramble();
+}
+
 void FUNCTION_Transmit()
 {
+	POWERSAVE_Activity();   // likely to get a reply
+
 	// if DTMF is enabled when TX'ing, it changes the TX audio filtering !! .. 1of11
 	BK4819_DisableDTMF();
 
@@ -180,20 +195,23 @@ void FUNCTION_Transmit()
 
 	gUpdateStatus = true;
 
-	GUI_DisplayScreen();
-
 	RADIO_SetTxParameters();
 
 	// turn the RED LED on
 	BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, true);
 
+	// the screen after the PA, redrawing it is a good part of the keying time
+	GUI_DisplayScreen();
+
 	DTMF_Reply();
 
 	if (gCurrentVfo->DTMF_PTT_ID_TX_MODE == PTT_ID_APOLLO)
-		BK4819_PlaySingleTone(2525, 250, 0, gEeprom.DTMF_SIDE_TONE);
+		AUDIO_SeqSingleTone(2525, 250, 0, gEeprom.DTMF_SIDE_TONE, false);
 
 #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
 	if (gAlarmState != ALARM_STATE_OFF) {
+		AUDIO_SeqFinish();
+
 		#ifdef ENABLE_TX1750
 		if (gAlarmState == ALARM_STATE_TX1750)
 			BK4819_TransmitTone(true, 1750);
@@ -214,10 +232,8 @@ void FUNCTION_Transmit()
 	}
 #endif
 
-	if (gCurrentVfo->SCRAMBLING_TYPE > 0 && gSetting_ScrambleEnable)
-		BK4819_EnableScramble(gCurrentVfo->SCRAMBLING_TYPE - 1);
-	else
-		BK4819_DisableScramble();
+	// after the PTT-ID tones, they use the same tone generator
+	AUDIO_SeqCall(SetupScramble, 0);
 
 	if (gSetting_backlight_on_tx_rx & BACKLIGHT_ON_TR_TX) {
 		BACKLIGHT_TurnOn();
@@ -231,6 +247,8 @@ void FUNCTION_Select(FUNCTION_Type_t Function)
 	const FUNCTION_Type_t PreviousFunction = gCurrentFunction;
 	const bool bWasPowerSave = PreviousFunction == FUNCTION_POWER_SAVE;
 
+	AUDIO_SeqFinish();   // don't pull the rug out from under any queued tones
+
 	gCurrentFunction = Function;
 
 	if (bWasPowerSave && Function != FUNCTION_POWER_SAVE) {
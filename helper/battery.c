@@ -17,7 +17,10 @@
 #include <assert.h>
 
 #include "battery.h"
+#include "board.h"
+#include "helper/battery_model.h"
 #include "driver/backlight.h"
+#include "driver/eeprom.h"
 #include "driver/st7565.h"
 #include "functions.h"
 #include "misc.h"
@@ -29,7 +32,6 @@
 uint16_t          gBatteryCalibration[6];
 uint16_t          gBatteryCurrentVoltage;
 uint16_t          gBatteryCurrent;
-uint16_t          gBatteryVoltages[4];
 uint16_t          gBatteryVoltageAverage;
 uint8_t           gBatteryDisplayLevel;
 bool              gChargingWithTypeC;
@@ -50,6 +52,15 @@ const uint16_t 	  lowBatteryPeriod = 30;
 
 volatile uint16_t gPowerSave_10ms;
 
+#define SAMPLE_10ms     10   // start a conversion every 100ms
+#define FILTER_SHIFT    5    // IIR, y += (x - y) / 32, ~3s time constant
+#define TX_HOLDOFF      10   // samples left out after TX while the cells recover
+
+static uint8_t  sampleCountdown;
+static bool     converting;
+static uint8_t  txHoldoff;
+static uint32_t filtered;    // raw ADC << FILTER_SHIFT, 0 until the first sample
+
 
 const uint16_t Voltage2PercentageTable[][7][2] = {
 	[BATTERY_TYPE_1600_MAH] = {
@@ -93,12 +104,32 @@ unsigned int BATTERY_VoltsToPercent(const unsigned int voltage_10mV)
 	return 0;
 }
 
+uint16_t BATTERY_GetVoltage(void)
+{
+	// nothing filtered yet, go with the last reading
+	const uint16_t Voltage = filtered ? (filtered >> FILTER_SHIFT) : gBatteryCurrentVoltage;
+
+	return (Voltage * 760) / gBatteryCalibration[3];
+}
+
+unsigned int BATTERY_GetPercent(void)
+{
+#ifdef ENABLE_BATTERY_MODEL
+	return BATMODEL_GetPercent();
+#else
+	return BATTERY_VoltsToPercent(gBatteryVoltageAverage);
+#endif
+}
+
 void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
 {
-	const uint8_t  PreviousBatteryLevel = gBatteryDisplayLevel;
-	const uint16_t Voltage              = (gBatteryVoltages[0] + gBatteryVoltages[1] + gBatteryVoltages[2] + gBatteryVoltages[3]) / 4;
+	const uint8_t PreviousBatteryLevel = gBatteryDisplayLevel;
 
-	gBatteryVoltageAverage = (Voltage * 760) / gBatteryCalibration[3];
+	gBatteryVoltageAverage = BATTERY_GetVoltage();
+
+#ifdef ENABLE_BATTERY_MODEL
+	BATMODEL_Update(gBatteryVoltageAverage, gBatteryCurrent >= 501);
+#endif
 
 	if(gBatteryVoltageAverage > 890)
 		gBatteryDisplayLevel = 7; // battery overvoltage
@@ -107,7 +138,7 @@ void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
 	else {
 		gBatteryDisplayLevel = 1;
 		const uint8_t levels[] = {5,17,41,65,88};
-		uint8_t perc = BATTERY_VoltsToPercent(gBatteryVoltageAverage);
+		uint8_t perc = BATTERY_GetPercent();
 		for(uint8_t i = 6; i >= 1; i--){
 			if (perc > levels[i-2]) {
 				gBatteryDisplayLevel = i;
@@ -165,6 +196,41 @@ void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
 	}
 }
 
+void BATTERY_TimeSlice10ms(void)
+{
+#ifdef ENABLE_BATTERY_MODEL
+	BATMODEL_TimeSlice10ms();
+#endif
+
+	if (converting) {
+		if (!BOARD_ADC_ReadBatteryInfo(&gBatteryCurrentVoltage, &gBatteryCurrent))
+			return;   // next tick
+
+		converting = false;
+
+		if (gCurrentFunction == FUNCTION_TRANSMIT) {
+			txHoldoff = TX_HOLDOFF;   // PA current sag, not the battery's state
+		}
+		else if (txHoldoff > 0) {
+			txHoldoff--;
+		}
+		else if (filtered == 0) {
+			filtered = (uint32_t)gBatteryCurrentVoltage << FILTER_SHIFT;
+		}
+		else {
+			filtered += gBatteryCurrentVoltage;
+			filtered -= filtered >> FILTER_SHIFT;
+		}
+	}
+
+	if (sampleCountdown > 0 && --sampleCountdown > 0)
+		return;
+
+	sampleCountdown = SAMPLE_10ms;
+	converting      = true;
+	BOARD_ADC_StartBatteryInfo();
+}
+
 void BATTERY_TimeSlice500ms(void)
 {
 	if (!gLowBattery) {
@@ -213,6 +279,11 @@ void BATTERY_TimeSlice500ms(void)
 	AUDIO_PlaySingleVoice(true);
 #endif
 
+#ifdef ENABLE_DEFERRED_SAVES
+	// APP_Update() stops before its flush once service is reduced
+	EEPROM_Flush();
+#endif
+
 	gReducedService = true;
 
 	FUNCTION_Select(FUNCTION_POWER_SAVE);
@@ -23,7 +23,6 @@
 extern uint16_t          gBatteryCalibration[6];
 extern uint16_t          gBatteryCurrentVoltage;
 extern uint16_t          gBatteryCurrent;
-extern uint16_t          gBatteryVoltages[4];
 extern uint16_t          gBatteryVoltageAverage;
 extern uint8_t           gBatteryDisplayLevel;
 extern bool              gChargingWithTypeC;
@@ -42,7 +41,15 @@ typedef enum {
 
 
 unsigned int BATTERY_VoltsToPercent(unsigned int voltage_10mV);
+// filtered battery voltage in 10mV units
+uint16_t BATTERY_GetVoltage(void);
+// charge left, from the battery model with ENABLE_BATTERY_MODEL, the voltage curve without
+unsigned int BATTERY_GetPercent(void);
 void BATTERY_GetReadings(bool bDisplayBatteryLevel);
+// runs the ADC without waiting on it, gBatteryCurrentVoltage and
+// gBatteryCurrent are the last raw readings (TX included), the filtered
+// voltage leaves out TX and the recovery after it
+void BATTERY_TimeSlice10ms(void);
 void BATTERY_TimeSlice500ms(void);
 
 #endif
@@ -0,0 +1,234 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifdef ENABLE_BATTERY_MODEL
+
+#include "driver/backlight.h"
+#include "driver/bk4819.h"
+#include "driver/eeprom.h"
+#include "functions.h"
+#include "helper/battery.h"
+#include "helper/battery_model.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+
+#define STORE_ADDRESS      0x1F90   // calibration area, survives a factory reset
+#define FULL_PERCENT       95       // charger unplugged at or above this starts a learning discharge
+#define LEARN_PERCENT      20       // and it's measured once down to this
+#define CORRECT_SHIFT      8        // count pulled 1/256 of the way to the voltage's each second
+#define CHARGE_SHIFT       4        // 1/16 on charge
+#define AVERAGE_SHIFT      8        // load average, ~4 minutes
+
+typedef struct {
+	uint16_t capacity_mAh;
+	uint16_t cycles;       // learnt discharges
+	uint8_t  type;         // BATTERY_Type_t it was learnt for
+	uint8_t  unused[2];
+	uint8_t  check;
+} Store_t;
+
+static const uint16_t nominal_mAh[] = {
+	[BATTERY_TYPE_1600_MAH] = 1600,
+	[BATTERY_TYPE_2200_MAH] = 2200,
+};
+
+static Store_t  store;
+static bool     seeded;
+static int32_t  remaining_mAs;
+static uint32_t second_mA;      // sum of this second's ticks
+static uint8_t  ticks;
+static uint32_t average_mA;     // << AVERAGE_SHIFT, 0 until the first second
+static bool     charging;
+static bool     learning;
+static uint32_t used_mAs;       // since the learning discharge started
+
+static uint8_t StoreCheck(const Store_t *pStore)
+{
+	const uint8_t *p   = (const uint8_t *)pStore;
+	uint8_t        sum = 0xA5;
+
+	for (unsigned int i = 0; i < sizeof(*pStore) - 1; i++)
+		sum += p[i];
+
+	return sum;
+}
+
+static uint32_t Capacity_mAs(void)
+{
+	return (uint32_t)store.capacity_mAh * 3600;
+}
+
+static uint16_t Load_mA(void)
+{
+	static const uint16_t tx_mA[] = {BATMODEL_TX_LOW_mA, BATMODEL_TX_MID_mA, BATMODEL_TX_HIGH_mA};
+	uint16_t mA;
+
+	switch (gCurrentFunction) {
+	case FUNCTION_TRANSMIT:
+		mA = tx_mA[gCurrentVfo->OUTPUT_POWER % ARRAY_SIZE(tx_mA)];
+		break;
+
+	case FUNCTION_MONITOR:
+	case FUNCTION_INCOMING:
+		mA = gEnableSpeaker ? BATMODEL_AUDIO_mA : BATMODEL_RX_mA;
+		break;
+
+	case FUNCTION_POWER_SAVE:
+		mA = gRxIdleMode ? BATMODEL_SLEEP_mA : BATMODEL_RX_mA;
+		break;
+
+	default:
+		mA = BATMODEL_RX_mA;
+		break;
+	}
+
+	return mA + BACKLIGHT_GetBrightness() * BATMODEL_BACKLIGHT_mA;
+}
+
+void BATMODEL_Init(void)
+{
+	const uint16_t nominal = nominal_mAh[gEeprom.BATTERY_TYPE];
+
+	EEPROM_ReadBuffer(STORE_ADDRESS, &store, sizeof(store));
+
+	if (store.check != StoreCheck(&store) || store.type != gEeprom.BATTERY_TYPE ||
+		store.capacity_mAh < nominal / 2 || store.capacity_mAh > nominal + nominal / 2)
+	{	// blank or another battery, start from the label
+		store.capacity_mAh = nominal;
+		store.cycles       = 0;
+		store.type         = gEeprom.BATTERY_TYPE;
+	}
+
+	seeded   = false;
+	learning = false;
+}
+
+void BATMODEL_TimeSlice10ms(void)
+{
+	second_mA += Load_mA();
+
+	if (++ticks < 100)
+		return;
+
+	const uint16_t mA = second_mA / 100;
+
+	ticks     = 0;
+	second_mA = 0;
+
+	if (average_mA == 0)
+		average_mA = (uint32_t)mA << AVERAGE_SHIFT;
+	else
+		average_mA += mA - (average_mA >> AVERAGE_SHIFT);
+
+	if (charging)
+		return;   // the charger carries the load
+
+	remaining_mAs = (remaining_mAs > mA) ? remaining_mAs - mA : 0;
+
+	if (learning)
+		used_mAs += mA;
+}
+
+static void Learn(const unsigned int percent)
+{
+	// what the whole battery would have given at this rate
+	const uint32_t measured = used_mAs / 36 / (100 - percent);
+	const uint16_t nominal  = nominal_mAh[store.type];
+
+	learning = false;
+
+	if (used_mAs < Capacity_mAs() / 4)
+		return;   // too short to go by
+
+	uint32_t capacity = (store.capacity_mAh * 3u + measured) / 4;
+
+	if (capacity < nominal / 2)
+		capacity = nominal / 2;
+	if (capacity > nominal + nominal / 2)
+		capacity = nominal + nominal / 2;
+
+	// keep the charge where it is, as a share of the new capacity
+	remaining_mAs = (int32_t)((uint64_t)remaining_mAs * capacity / store.capacity_mAh);
+
+	store.capacity_mAh = capacity;
+	store.cycles++;
+	store.check = StoreCheck(&store);
+	EEPROM_WriteBuffer(STORE_ADDRESS, &store);
+}
+
+void BATMODEL_Update(const uint16_t Voltage, const bool bCharging)
+{
+	// what it would read with nothing connected
+	const uint16_t     rest    = Voltage + (uint32_t)Load_mA() * BATMODEL_RESISTANCE_mOHM / 10000;
+	const unsigned int percent = BATTERY_VoltsToPercent(rest);
+	const int32_t      target  = Capacity_mAs() / 100 * percent;
+
+	if (!seeded) {
+		remaining_mAs = target;
+		seeded        = true;
+	}
+	else if (bCharging) {
+		remaining_mAs += (target - remaining_mAs) / (1 << CHARGE_SHIFT);
+	}
+	else {
+		remaining_mAs += (target - remaining_mAs) / (1 << CORRECT_SHIFT);
+	}
+
+	if (bCharging) {
+		learning = false;   // partial discharges don't tell us anything
+	}
+	else if (charging && percent >= FULL_PERCENT) {
+		// just come off the charger full
+		remaining_mAs = Capacity_mAs();
+		used_mAs      = 0;
+		learning      = true;
+	}
+	else if (learning && percent <= LEARN_PERCENT) {
+		Learn(percent);
+	}
+
+	charging = bCharging;
+}
+
+uint8_t BATMODEL_GetPercent(void)
+{
+	if (!seeded)
+		return BATTERY_VoltsToPercent(gBatteryVoltageAverage);
+
+	const uint32_t percent = ((uint32_t)remaining_mAs * 100 + Capacity_mAs() / 2) / Capacity_mAs();
+
+	return (percent > 100) ? 100 : percent;
+}
+
+uint16_t BATMODEL_GetMinutesLeft(void)
+{
+	const uint32_t mA = average_mA >> AVERAGE_SHIFT;
+
+	if (!seeded || mA == 0 || charging)
+		return 0xFFFF;
+
+	const uint32_t minutes = (uint32_t)remaining_mAs / mA / 60;
+
+	return (minutes < 0xFFFF) ? minutes : 0xFFFE;
+}
+
+uint16_t BATMODEL_GetCapacity_mAh(void)
+{
+	return store.capacity_mAh;
+}
+
+#endif
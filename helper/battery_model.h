@@ -0,0 +1,78 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef BATTERY_MODEL_H
+#define BATTERY_MODEL_H
+
+#ifdef ENABLE_BATTERY_MODEL
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// battery charge by coulomb counting
+//
+// there's no current sense on the battery, so the draw is estimated from
+// what the radio is doing (TX power, RX with/without audio, battery save,
+// backlight level) and taken off the charge every second. The voltage
+// curve still keeps it honest: at rest the voltage, corrected for the
+// estimated load through the cells' internal resistance, is converted to
+// a charge and the count is pulled slowly towards it (quickly on charge,
+// when the charging current isn't known).
+// The capacity is learnt from discharges that start at full charge and
+// get down to the steep low end of the curve, and is kept in EEPROM.
+//
+// the figures below are rough UV-K5 ones and can be changed when building
+
+#ifndef BATMODEL_TX_LOW_mA
+	#define BATMODEL_TX_LOW_mA          600
+#endif
+#ifndef BATMODEL_TX_MID_mA
+	#define BATMODEL_TX_MID_mA          1000
+#endif
+#ifndef BATMODEL_TX_HIGH_mA
+	#define BATMODEL_TX_HIGH_mA         1500
+#endif
+#ifndef BATMODEL_AUDIO_mA
+	#define BATMODEL_AUDIO_mA           150    // RX, speaker on
+#endif
+#ifndef BATMODEL_RX_mA
+	#define BATMODEL_RX_mA              38     // RX, squelch closed
+#endif
+#ifndef BATMODEL_SLEEP_mA
+	#define BATMODEL_SLEEP_mA           12     // battery save, BK4819 asleep
+#endif
+#ifndef BATMODEL_BACKLIGHT_mA
+	#define BATMODEL_BACKLIGHT_mA       4      // per brightness step
+#endif
+#ifndef BATMODEL_RESISTANCE_mOHM
+	#define BATMODEL_RESISTANCE_mOHM    200    // 2S pack + wiring
+#endif
+
+// load the learnt capacity, boot and battery type change
+void     BATMODEL_Init(void);
+// count the charge used
+void     BATMODEL_TimeSlice10ms(void);
+// once a second when not transmitting, voltage in 10mV units
+void     BATMODEL_Update(uint16_t Voltage, bool bCharging);
+
+uint8_t  BATMODEL_GetPercent(void);
+// at the average draw of the last few minutes, 0xFFFF if not known yet
+uint16_t BATMODEL_GetMinutesLeft(void);
+uint16_t BATMODEL_GetCapacity_mAh(void);
+
+#endif
+
+#endif
@@ -18,6 +18,7 @@
 
 #ifdef ENABLE_AIRCOPY
 	#include "app/aircopy.h"
+	#include "app/fsk.h"
 #endif
 #include "bsp/dp32g030/gpio.h"
 #include "driver/bk4819.h"
@@ -25,6 +26,7 @@
 #include "driver/gpio.h"
 #include "driver/system.h"
 #include "helper/boot.h"
+#include "key_queue.h"
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
@@ -46,10 +48,7 @@ BOOT_Mode_t BOOT_GetMode(void)
 
 	if (Keys[0] == Keys[1])
 	{
-		gKeyReading0 = Keys[0];
-		gKeyReading1 = Keys[0];
-
-		gDebounceCounter = 2;
+		KEYQ_Reset(Keys[0]);   // already down, don't report it pressed again
 
 		if (Keys[0] == KEY_SIDE1)
 			return BOOT_MODE_F_LOCK;
@@ -96,8 +95,7 @@ void BOOT_ProcessMode(BOOT_Mode_t Mode)
 			gCurrentVfo = gRxVfo;
 
 			RADIO_SetupRegisters(true);
-			BK4819_SetupAircopy();
-			BK4819_ResetFSK();
+			FSK_Init();
 
 			gAircopyState = AIRCOPY_READY;
 
@@ -0,0 +1,133 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "key_queue.h"
+
+KEYQ_Timing_t gKeyTiming = {
+	.debounce_10ms   = KEYQ_DEBOUNCE_DEFAULT,
+	.long_press_10ms = KEYQ_LONG_PRESS_DEFAULT,
+	.repeat_10ms     = KEYQ_REPEAT_DEFAULT,
+};
+
+static struct {
+	KEY_Event_t event[KEYQ_LEN];
+	uint8_t     head;         // next to write
+	uint8_t     tail;         // next to read
+} queue;
+
+static struct {
+	uint8_t  reading;         // raw reading being debounced
+	uint32_t reading_since;
+	uint8_t  key;             // debounced key down
+	uint32_t key_since;       // when it first read down
+	uint32_t next_repeat;
+	bool     held;
+} scan = {
+	.reading = KEY_INVALID,
+	.key     = KEY_INVALID,
+};
+
+static void Add(const KEY_EventType_t Type, const uint32_t Time)
+{
+	const KEY_Event_t event = {
+		.time_10ms = Time,
+		.key       = scan.key,
+		.type      = Type,
+		.held      = scan.held,
+	};
+
+	KEYQ_Put(&event);
+}
+
+void KEYQ_Reset(KEY_Code_t Key)
+{
+	queue.head   = 0;
+	queue.tail   = 0;
+	scan.reading = Key;
+	scan.key     = Key;
+	scan.held    = false;
+}
+
+void KEYQ_Scan(KEY_Code_t Key, uint32_t Now_10ms)
+{
+	if (Key != scan.reading) {
+		scan.reading       = Key;
+		scan.reading_since = Now_10ms;
+		return;
+	}
+
+	if (Now_10ms - scan.reading_since < gKeyTiming.debounce_10ms)
+		return;   // not settled yet
+
+	if (Key != scan.key) {
+		// released, or another key without releasing the last one,
+		// both stamped with when the reading first changed
+		if (scan.key != KEY_INVALID)
+			Add(KEY_EVENT_RELEASE, scan.reading_since);
+
+		scan.key       = Key;
+		scan.key_since = scan.reading_since;
+		scan.held      = false;
+
+		if (Key != KEY_INVALID)
+			Add(KEY_EVENT_PRESS, scan.key_since);
+
+		return;
+	}
+
+	if (Key == KEY_INVALID)
+		return;
+
+	if (!scan.held) {
+		if (Now_10ms - scan.key_since >= gKeyTiming.long_press_10ms) {
+			scan.held        = true;
+			scan.next_repeat = Now_10ms + gKeyTiming.repeat_10ms;
+			Add(KEY_EVENT_LONG, Now_10ms);
+		}
+	}
+	else if ((Key == KEY_UP || Key == KEY_DOWN) && (int32_t)(Now_10ms - scan.next_repeat) >= 0) {
+		// one repeat however late we are, then back in step
+		scan.next_repeat = Now_10ms + gKeyTiming.repeat_10ms;
+		Add(KEY_EVENT_REPEAT, Now_10ms);
+	}
+}
+
+bool KEYQ_Put(const KEY_Event_t *pEvent)
+{
+	const uint8_t next = (queue.head + 1) % KEYQ_LEN;
+
+	if (next == queue.tail)
+		return false;   // full, 15 events behind means the main loop's stuck anyway
+
+	queue.event[queue.head] = *pEvent;
+	queue.head              = next;
+	return true;
+}
+
+bool KEYQ_Get(KEY_Event_t *pEvent)
+{
+	if (queue.tail == queue.head)
+		return false;
+
+	*pEvent    = queue.event[queue.tail];
+	queue.tail = (queue.tail + 1) % KEYQ_LEN;
+	return true;
+}
+
+KEY_Code_t KEYQ_KeyDown(void)
+{
+	return scan.key;
+}
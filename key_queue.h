@@ -0,0 +1,72 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef KEY_QUEUE_H
+#define KEY_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "driver/keyboard.h"
+
+// keypad events
+//
+// the 10ms tick hands KEYQ_Scan() what the keypad reads, it debounces that
+// and queues press/long/repeat/release events stamped with the tick count,
+// CheckKeys() then feeds them to ProcessKey() in order. Timing goes by the
+// stamps rather than by counting calls, so a slow pass through the main
+// loop doesn't stretch a long press or lose a quick tap between two keys.
+// No hardware in here, `make key_queue_sim` runs it on the PC.
+
+typedef enum {
+	KEY_EVENT_PRESS = 0,
+	KEY_EVENT_LONG,          // held for gKeyTiming.long_press_10ms
+	KEY_EVENT_REPEAT,        // still held, UP/DOWN only, every gKeyTiming.repeat_10ms
+	KEY_EVENT_RELEASE
+} KEY_EventType_t;
+
+typedef struct {
+	uint32_t time_10ms;      // when it happened, gGlobalSysTickCounter
+	uint8_t  key;            // KEY_Code_t
+	uint8_t  type;           // KEY_EventType_t
+	bool     held;           // RELEASE: the key had been long pressed
+} KEY_Event_t;
+
+typedef struct {
+	uint8_t debounce_10ms;
+	uint8_t long_press_10ms;
+	uint8_t repeat_10ms;
+} KEYQ_Timing_t;
+
+#define KEYQ_DEBOUNCE_DEFAULT      2     // 20ms
+#define KEYQ_LONG_PRESS_DEFAULT    40    // 400ms
+#define KEYQ_REPEAT_DEFAULT        8     // 80ms
+
+#define KEYQ_LEN                   16    // power of 2
+
+extern KEYQ_Timing_t gKeyTiming;
+
+// forget everything, Key is taken as already down (its release is still reported)
+void       KEYQ_Reset(KEY_Code_t Key);
+// from the tick, Key is the raw keypad reading
+void       KEYQ_Scan(KEY_Code_t Key, uint32_t Now_10ms);
+// false if the queue is full
+bool       KEYQ_Put(const KEY_Event_t *pEvent);
+bool       KEYQ_Get(KEY_Event_t *pEvent);
+// the debounced key that's down, KEY_INVALID if none
+KEY_Code_t KEYQ_KeyDown(void);
+
+#endif
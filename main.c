@@ -21,9 +21,15 @@
 #ifdef ENABLE_AM_FIX
 	#include "am_fix.h"
 #endif
+#ifdef ENABLE_CHANNEL_BANKS
+	#include "channel_bank.h"
+#endif
 
+#include "ARMCM0.h"
 #include "audio.h"
 #include "board.h"
+#include "functions.h"
+#include "key_queue.h"
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
@@ -44,6 +50,7 @@
 #endif
 
 #include "helper/battery.h"
+#include "helper/battery_model.h"
 #include "helper/boot.h"
 
 #include "ui/lock.h"
@@ -93,6 +100,9 @@ void Main(void)
 	BOARD_ADC_GetBatteryInfo(&gBatteryCurrentVoltage, &gBatteryCurrent);
 
 	SETTINGS_InitEEPROM();
+#ifdef ENABLE_CHANNEL_BANKS
+	CHBANK_Resume();
+#endif
 	SETTINGS_WriteBuildOptions();
 	SETTINGS_LoadCalibration();
 
@@ -103,9 +113,11 @@ void Main(void)
 
 	RADIO_SetupRegisters(true);
 
-	for (unsigned int i = 0; i < ARRAY_SIZE(gBatteryVoltages); i++)
-		BOARD_ADC_GetBatteryInfo(&gBatteryVoltages[i], &gBatteryCurrent);
+	BOARD_ADC_GetBatteryInfo(&gBatteryCurrentVoltage, &gBatteryCurrent);
 
+#ifdef ENABLE_BATTERY_MODEL
+	BATMODEL_Init();
+#endif
 	BATTERY_GetReadings(false);
 
 #ifdef ENABLE_AM_FIX
@@ -142,9 +154,7 @@ void Main(void)
 			i = (GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_PTT) && KEYBOARD_Poll() == KEY_INVALID) ? i + 1 : 0;
 			SYSTEM_DelayMs(10);
 		}
-		gKeyReading0 = KEY_INVALID;
-		gKeyReading1 = KEY_INVALID;
-		gDebounceCounter = 0;
+		KEYQ_Reset(KEY_INVALID);
 	}
 
 	if (!gChargingWithTypeC && gBatteryDisplayLevel == 0)
@@ -174,8 +184,10 @@ void Main(void)
 					break;
 				}
 #ifdef ENABLE_BOOT_BEEPS
-				if ((boot_counter_10ms % 25) == 0)
+				if ((boot_counter_10ms % 25) == 0) {
 					AUDIO_PlayBeep(BEEP_880HZ_40MS_OPTIONAL);
+					AUDIO_SeqFinish();
+				}
 #endif
 			}
 		}
@@ -230,5 +242,16 @@ void Main(void)
 				APP_TimeSlice500ms();
 			}
 		}
+		else if (gCurrentFunction == FUNCTION_POWER_SAVE) {
+			// everything in power save runs off the tick, so rather than
+			// spinning stop the core until it (or the wake up window) comes
+			static uint32_t sleepClocks;
+
+			sleepClocks += SYSTEM_Sleep(&gNextTimeslice);
+			while (sleepClocks >= SysTick->LOAD + 1) {
+				sleepClocks -= SysTick->LOAD + 1;
+				gPowerSaveStats.mcu_sleep_ticks++;
+			}
+		}
 	}
 }
@@ -38,9 +38,6 @@ const uint8_t     DTMF_txstop_countdown_500ms      =  3000 / 500;  // 6 seconds
 
 const uint8_t     key_input_timeout_500ms          =  8000 / 500;  // 8 seconds
 
-const uint16_t    key_repeat_delay_10ms            =   400 / 10;   // 400ms
-const uint16_t    key_repeat_10ms                  =    80 / 10;   // 80ms .. MUST be less than 'key_repeat_delay'
-const uint16_t    key_debounce_10ms                =    20 / 10;   // 20ms
 
 const uint8_t     scan_delay_10ms                  =   210 / 10;   // 210ms
 
@@ -71,6 +68,10 @@ const uint16_t    power_save2_10ms                 =   200 / 10;   // 200ms
 	const uint16_t    vox_stop_count_down_10ms         =  1000 / 10;   // 1 second
 #endif
 
+#ifdef ENABLE_DEFERRED_SAVES
+	const uint16_t    eeprom_write_delay_10ms          =  2000 / 10;   // 2 seconds without a save before the deferred ones are written
+#endif
+
 const uint16_t    NOAA_countdown_10ms              =  5000 / 10;   // 5 seconds
 const uint16_t    NOAA_countdown_2_10ms            =   500 / 10;   // 500ms
 const uint16_t    NOAA_countdown_3_10ms            =   200 / 10;   // 200ms
@@ -110,11 +111,15 @@ uint8_t           gTryCount;
 
 uint16_t          gEEPROM_RSSI_CALIB[7][4];
 
+SquelchThresholds_t gSquelchThresholds[2][10];
+
 uint16_t          gEEPROM_1F8A;
 uint16_t          gEEPROM_1F8C;
 
 ChannelAttributes_t gMR_ChannelAttributes[FREQ_CHANNEL_LAST + 1];
 
+volatile PowerSaveStats_t gPowerSaveStats;
+
 volatile uint16_t gBatterySaveCountdown_10ms = battery_save_count_10ms;
 
 volatile bool     gPowerSaveCountdownExpired;
@@ -122,6 +127,11 @@ volatile bool     gSchedulePowerSave;
 
 volatile bool     gScheduleDualWatch = true;
 
+#ifdef ENABLE_DEFERRED_SAVES
+	volatile uint16_t gEepromWriteCountdown_10ms;
+	volatile bool     gScheduleEepromWrite;
+#endif
+
 volatile uint16_t gDualWatchCountdown_10ms;
 bool              gDualWatchActive           = false;
 
@@ -154,7 +164,6 @@ int16_t           gVFO_RSSI[2];
 uint8_t           gVFO_RSSI_bar_level[2];
 
 uint8_t           gReducedService;
-uint8_t           gBatteryVoltageIndex;
 bool     		  gCssBackgroundScan;
 
 volatile bool     gScheduleScanListen = true;
@@ -213,7 +222,6 @@ uint8_t           gPttDebounceCounter;
 uint8_t           gMenuListCount;
 uint8_t           gBackup_CROSS_BAND_RX_TX;
 uint8_t           gScanDelay_10ms;
-uint8_t           gFSKWriteIndex;
 
 #ifdef ENABLE_NOAA
 	bool          gIsNoaaMode;
@@ -227,6 +235,8 @@ bool              gF_LOCK = false;
 uint8_t           gShowChPrefix;
 
 volatile bool     gNextTimeslice;
+volatile uint32_t gGlobalSysTickCounter;
+volatile bool     gRssiCacheExpired = true;
 volatile uint8_t  gFoundCDCSSCountdown_10ms;
 volatile uint8_t  gFoundCTCSSCountdown_10ms;
 #ifdef ENABLE_VOX
@@ -98,9 +98,6 @@ extern const uint8_t         DTMF_txstop_countdown_500ms;
 
 extern const uint8_t         key_input_timeout_500ms;
 
-extern const uint16_t        key_repeat_delay_10ms;
-extern const uint16_t        key_repeat_10ms;
-extern const uint16_t        key_debounce_10ms;
 
 extern const uint8_t         scan_delay_10ms;
 
@@ -113,6 +110,10 @@ extern const uint16_t        power_save2_10ms;
 	extern const uint16_t    vox_stop_count_down_10ms;
 #endif
 
+#ifdef ENABLE_DEFERRED_SAVES
+	extern const uint16_t    eeprom_write_delay_10ms;
+#endif
+
 extern const uint16_t        NOAA_countdown_10ms;
 extern const uint16_t        NOAA_countdown_2_10ms;
 extern const uint16_t        NOAA_countdown_3_10ms;
@@ -172,6 +173,18 @@ extern uint8_t               gTryCount;
 
 extern uint16_t              gEEPROM_RSSI_CALIB[7][4];
 
+typedef struct {
+	uint8_t OpenRSSI;        // 0 ~ 255
+	uint8_t CloseRSSI;
+	uint8_t OpenNoise;       // 127 ~ 0
+	uint8_t CloseNoise;
+	uint8_t CloseGlitch;     // 255 ~ 0
+	uint8_t OpenGlitch;
+} SquelchThresholds_t;
+
+// [VHF, UHF][squelch level], level 0 is squelch off
+extern SquelchThresholds_t   gSquelchThresholds[2][10];
+
 extern uint16_t              gEEPROM_1F8A;
 extern uint16_t              gEEPROM_1F8C;
 
@@ -188,6 +201,15 @@ typedef union {
 
 extern ChannelAttributes_t   gMR_ChannelAttributes[207];
 
+typedef struct {
+	uint32_t ticks;              // 10ms ticks since the stats were last read
+	uint32_t power_save_ticks;   // .. of those in FUNCTION_POWER_SAVE
+	uint32_t rx_off_ticks;       // .. with the BK4819 asleep
+	uint32_t mcu_sleep_ticks;    // .. the MCU core spent stopped (WFI), summed up
+} PowerSaveStats_t;
+
+extern volatile PowerSaveStats_t gPowerSaveStats;
+
 extern volatile uint16_t     gBatterySaveCountdown_10ms;
 
 extern volatile bool         gPowerSaveCountdownExpired;
@@ -195,6 +217,11 @@ extern volatile bool         gSchedulePowerSave;
 
 extern volatile bool         gScheduleDualWatch;
 
+#ifdef ENABLE_DEFERRED_SAVES
+	extern volatile uint16_t gEepromWriteCountdown_10ms;
+	extern volatile bool     gScheduleEepromWrite;
+#endif
+
 extern volatile uint16_t     gDualWatchCountdown_10ms;
 extern bool                  gDualWatchActive;
 
@@ -225,7 +252,6 @@ extern uint8_t               gVFO_RSSI_bar_level[2];
 
 // battery critical, limit functionality to minimum
 extern uint8_t               gReducedService;
-extern uint8_t               gBatteryVoltageIndex;
 
 // we are searching CTCSS/DCS inside RX ctcss/dcs menu
 extern bool         gCssBackgroundScan;
@@ -293,12 +319,14 @@ extern uint8_t               gPttDebounceCounter;
 extern uint8_t               gMenuListCount;
 extern uint8_t               gBackup_CROSS_BAND_RX_TX;
 extern uint8_t               gScanDelay_10ms;
-extern uint8_t               gFSKWriteIndex;
 #ifdef ENABLE_NOAA
 	extern bool              gIsNoaaMode;
 	extern uint8_t           gNoaaChannel;
 #endif
 extern volatile bool         gNextTimeslice;
+// 10ms ticks since boot
+extern volatile uint32_t     gGlobalSysTickCounter;
+extern volatile bool         gRssiCacheExpired;
 extern bool                  gUpdateDisplay;
 extern bool                  gF_LOCK;
 #ifdef ENABLE_FMRADIO
@@ -0,0 +1,111 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+
+#include <stdbool.h>
+
+#include "driver/eeprom.h"
+#include "frequencies.h"
+#include "misc.h"
+#include "name_index.h"
+
+static uint32_t keys[MR_CHANNEL_LAST + 1];   // key i in bits 4i..4i+3, 0xF past the end
+static bool     valid;
+
+static uint8_t Key(char c)
+{
+	static const char letters[] = "22233344455566677778889999";
+
+	if (c >= 'a' && c <= 'z')
+		c -= 'a' - 'A';
+	if (c >= 'A' && c <= 'Z')
+		return letters[c - 'A'] - '0';
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	return (c == ' ') ? 0 : 1;
+}
+
+// the name as SETTINGS_FetchChannelName() shows it: up to the first
+// character that isn't printable, without the trailing spaces
+static uint32_t Keys(const char *pName)
+{
+	uint32_t value  = 0xFFFFFFFF;
+	uint8_t  length = 0;
+
+	while (length < 10 && (uint8_t)pName[length] >= 32 && (uint8_t)pName[length] <= 127)
+		length++;
+	while (length > 0 && pName[length - 1] == ' ')
+		length--;
+
+	for (uint8_t i = 0; i < length && i < NAMEIDX_KEYS; i++)
+		value = (value & ~(0xFu << (i * 4))) | ((uint32_t)Key(pName[i]) << (i * 4));
+
+	return value;
+}
+
+static void Build(void)
+{
+	char name[10];
+
+	for (unsigned int i = 0; i <= MR_CHANNEL_LAST; i++) {
+		EEPROM_ReadBuffer(0x0F50 + (i * 16), name, sizeof(name));
+		keys[i] = Keys(name);
+	}
+
+	valid = true;
+}
+
+void NAMEIDX_Invalidate(void)
+{
+	valid = false;
+}
+
+void NAMEIDX_Update(uint8_t Channel, const char *pName)
+{
+	if (valid && IS_MR_CHANNEL(Channel))
+		keys[Channel] = Keys(pName);
+}
+
+uint8_t NAMEIDX_Find(const uint8_t *pKeys, uint8_t Count, uint8_t From, int8_t Direction)
+{
+	uint32_t want = 0;
+
+	if (Count == 0 || Count > NAMEIDX_KEYS || !IS_MR_CHANNEL(From))
+		return 0xFF;
+
+	if (!valid)
+		Build();
+
+	for (uint8_t i = 0; i < Count; i++)
+		want |= (uint32_t)pKeys[i] << (i * 4);
+
+	const uint32_t mask = (Count == NAMEIDX_KEYS) ? 0xFFFFFFFF : (1u << (Count * 4)) - 1;
+
+	for (unsigned int i = 0, channel = From; i <= MR_CHANNEL_LAST; i++) {
+		if ((keys[channel] & mask) == want && gMR_ChannelAttributes[channel].band <= BAND7_470MHz)
+			return channel;
+
+		if (Direction < 0)
+			channel = (channel == 0) ? MR_CHANNEL_LAST : channel - 1;
+		else
+			channel = (channel == MR_CHANNEL_LAST) ? 0 : channel + 1;
+	}
+
+	return 0xFF;
+}
+
+#endif
@@ -0,0 +1,43 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+
+#include <stdint.h>
+
+// memory channel names by keypad digits
+//
+// the first NAMEIDX_KEYS characters of each channel name are kept in RAM
+// as the keys they're on (ABC 2 .. WXYZ 9, digits on themselves, space 0,
+// anything else 1), 4 bits a key, so finding the channels whose name starts
+// with what's been typed so far doesn't go near the EEPROM. It's read in
+// on the first search, SETTINGS_SaveChannelName() keeps it up to date
+
+#define NAMEIDX_KEYS    8
+
+// the names have been changed some other way (UART, a channel bank)
+void    NAMEIDX_Invalidate(void);
+void    NAMEIDX_Update(uint8_t Channel, const char *pName);
+// the first channel from From on in Direction (1 or -1, round the end)
+// with a name starting with the Count keys, 0xFF if there's none
+uint8_t NAMEIDX_Find(const uint8_t *pKeys, uint8_t Count, uint8_t From, int8_t Direction);
+
+#endif
+
+#endif
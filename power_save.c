@@ -0,0 +1,58 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "power_save.h"
+
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+	static uint16_t hang_10ms;
+	static uint16_t sleep_10ms;
+#endif
+
+void POWERSAVE_Activity(void)
+{
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+	hang_10ms  = POWERSAVE_HANG_10ms;
+	sleep_10ms = 0;
+#endif
+}
+
+uint16_t POWERSAVE_NextSleep_10ms(const uint8_t Ratio)
+{
+	const uint16_t nominal = Ratio * POWERSAVE_WAKE_10ms;
+
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+	if (hang_10ms > 0) {
+		// recent traffic, a reply is likely, keep the latency down
+		const uint16_t cycle = POWERSAVE_MIN_SLEEP_10ms + POWERSAVE_WAKE_10ms;
+		hang_10ms = (hang_10ms > cycle) ? hang_10ms - cycle : 0;
+		return POWERSAVE_MIN_SLEEP_10ms;
+	}
+
+	// quiet channel, stretch it out a step at a time
+	if (sleep_10ms < nominal)
+		sleep_10ms = nominal;
+	else
+	if (sleep_10ms < POWERSAVE_MAX_SLEEP_10ms) {
+		sleep_10ms += POWERSAVE_STEP_10ms;
+		if (sleep_10ms > POWERSAVE_MAX_SLEEP_10ms)
+			sleep_10ms = POWERSAVE_MAX_SLEEP_10ms;
+	}
+
+	return sleep_10ms;
+#else
+	return nominal;
+#endif
+}
@@ -0,0 +1,62 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef POWER_SAVE_H
+#define POWER_SAVE_H
+
+#include <stdint.h>
+
+// battery save sleep length
+//
+// without ENABLE_ADAPTIVE_POWER_SAVE it's the stock fixed ratio, 1:N sleeps
+// N * 100ms between 100ms RX windows. With it the sleep follows the traffic:
+// short for a while after the channel was busy (replies come quickly), the
+// 1:N setting after that, then slowly longer while it stays quiet, up to
+// the point where too many calls would lose too much of their start.
+//
+// a call starting at a random moment is heard after the rest of the current
+// sleep, so with sleep S and RX window W the chance of losing more than the
+// first L of it is (S - L) / (S + W). Keeping that under P gives
+//
+//   S <= (L + P * W) / (1 - P)
+//
+// L and P can be changed when building, `make power_save_sim` shows what
+// they do to battery life and call latency with a synthetic traffic model
+
+#define POWERSAVE_WAKE_10ms             10     // RX window, power_save1_10ms
+
+#ifndef POWERSAVE_PREAMBLE_10ms
+	#define POWERSAVE_PREAMBLE_10ms     50     // L, start of a call we can afford to lose
+#endif
+#ifndef POWERSAVE_MISS_PERCENT
+	#define POWERSAVE_MISS_PERCENT      10     // P, calls allowed to lose more than that
+#endif
+#ifndef POWERSAVE_HANG_10ms
+	#define POWERSAVE_HANG_10ms         3000   // short sleeps for this long once back in power save after traffic
+#endif
+#ifndef POWERSAVE_STEP_10ms
+	#define POWERSAVE_STEP_10ms         2      // added per quiet sleep
+#endif
+
+#define POWERSAVE_MIN_SLEEP_10ms        POWERSAVE_WAKE_10ms   // 1:1
+#define POWERSAVE_MAX_SLEEP_10ms        ((POWERSAVE_PREAMBLE_10ms * 100 + POWERSAVE_MISS_PERCENT * POWERSAVE_WAKE_10ms) / (100 - POWERSAVE_MISS_PERCENT))
+
+// something happened on the channel (squelch open, VOX, DTMF, our own TX)
+void     POWERSAVE_Activity(void);
+// how long to sleep this time, Ratio is gEeprom.BATTERY_SAVE (1 to 4)
+uint16_t POWERSAVE_NextSleep_10ms(const uint8_t Ratio);
+
+#endif
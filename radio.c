@@ -18,10 +18,14 @@
 #include <string.h>
 
 #include "am_fix.h"
+#include "app/chFrScanner.h"
 #include "app/dtmf.h"
 #ifdef ENABLE_FMRADIO
 	#include "app/fm.h"
 #endif
+#ifdef ENABLE_SW_VOX
+	#include "app/vox.h"
+#endif
 #include "audio.h"
 #include "bsp/dp32g030/gpio.h"
 #include "dcs.h"
@@ -29,12 +33,14 @@
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
 #include "driver/system.h"
+#include "driver/systick.h"
 #include "frequencies.h"
 #include "functions.h"
 #include "helper/battery.h"
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
+#include "tail.h"
 #include "ui/menu.h"
 
 VFO_Info_t    *gTxVfo;
@@ -42,6 +48,62 @@ VFO_Info_t    *gRxVfo;
 VFO_Info_t    *gCurrentVfo;
 DCS_CodeType_t gCurrentCodeType;
 VfoState_t     VfoState[2];
+uint32_t       gTxSetup_us;
+
+static uint32_t txStart_us;
+static bool     txTiming;
+
+static void ComputeTxSetup(VFO_Info_t *pInfo)
+{
+	RADIO_TxSetup_t         *pSetup    = &pInfo->TxSetup;
+	const FREQ_Config_t     *pConfig   = pInfo->pTX;
+	BK4819_FilterBandwidth_t Bandwidth = pInfo->CHANNEL_BANDWIDTH;
+
+	if (Bandwidth != BK4819_FILTER_BW_WIDE && Bandwidth != BK4819_FILTER_BW_NARROW)
+		Bandwidth = BK4819_FILTER_BW_WIDE;
+
+	pSetup->Frequency = pConfig->Frequency;
+	pSetup->Bandwidth = pInfo->CHANNEL_BANDWIDTH;
+	pSetup->TXP       = pInfo->TXP_CalculatedSetting;
+	pSetup->CodeType  = pConfig->CodeType;
+	pSetup->Code      = pConfig->Code;
+
+#ifdef ENABLE_AM_FIX
+	pSetup->FilterReg = BK4819_GetFilterBandwidthReg(Bandwidth, true);
+#else
+	pSetup->FilterReg = BK4819_GetFilterBandwidthReg(Bandwidth, false);
+#endif
+	pSetup->PowerReg  = BK4819_GetPowerAmplifierReg(pInfo->TXP_CalculatedSetting, pConfig->Frequency);
+
+	switch (pConfig->CodeType)
+	{
+		default:
+		case CODE_TYPE_OFF:
+			pSetup->SubAudio = 0;
+			break;
+
+		case CODE_TYPE_CONTINUOUS_TONE:
+			pSetup->SubAudio = CTCSS_Options[pConfig->Code];
+			break;
+
+		case CODE_TYPE_DIGITAL:
+		case CODE_TYPE_REVERSE_DIGITAL:
+			pSetup->SubAudio = DCS_GetGolayCodeWord(pConfig->CodeType, pConfig->Code);
+			break;
+	}
+}
+
+// false if something was changed without the VFO being reconfigured
+static bool TxSetupValid(const VFO_Info_t *pInfo)
+{
+	const RADIO_TxSetup_t *pSetup = &pInfo->TxSetup;
+
+	return pSetup->Frequency == pInfo->pTX->Frequency
+		&& pSetup->Bandwidth == pInfo->CHANNEL_BANDWIDTH
+		&& pSetup->TXP       == pInfo->TXP_CalculatedSetting
+		&& pSetup->CodeType  == pInfo->pTX->CodeType
+		&& pSetup->Code      == pInfo->pTX->Code;
+}
 
 const char gModulationStr[MODULATION_UKNOWN][4] = {
 	[MODULATION_FM]="FM",
@@ -113,6 +175,8 @@ void RADIO_InitInfo(VFO_Info_t *pInfo, const uint8_t ChannelSave, const uint32_t
 	pInfo->pRX                      = &pInfo->freq_config_RX;
 	pInfo->pTX                      = &pInfo->freq_config_TX;
 	pInfo->Compander                = 0;  // off
+	pInfo->TAIL_MODE                = TAIL_MODE_DEFAULT;
+	pInfo->TAIL_TIME                = TAIL_TIME_DEFAULT;
 
 	if (ChannelSave == (FREQ_CHANNEL_FIRST + BAND2_108MHz))
 		pInfo->Modulation = MODULATION_AM;
@@ -289,6 +353,7 @@ void RADIO_ConfigureChannel(const unsigned int VFO, const unsigned int configure
 			pVfo->CHANNEL_BANDWIDTH = BK4819_FILTER_BW_WIDE;
 			pVfo->OUTPUT_POWER      = OUTPUT_POWER_LOW;
 			pVfo->BUSY_CHANNEL_LOCK = false;
+			pVfo->TAIL_TIME         = TAIL_TIME_DEFAULT;
 		}
 		else
 		{
@@ -297,6 +362,9 @@ void RADIO_ConfigureChannel(const unsigned int VFO, const unsigned int configure
 			pVfo->CHANNEL_BANDWIDTH = !!((d4 >> 1) & 1u);
 			pVfo->OUTPUT_POWER      =   ((d4 >> 2) & 3u);
 			pVfo->BUSY_CHANNEL_LOCK = !!((d4 >> 4) & 1u);
+			pVfo->TAIL_TIME         =   ((d4 >> 5) & 7u);
+			if (pVfo->TAIL_TIME == 0)
+				pVfo->TAIL_TIME = TAIL_TIME_DEFAULT;   // channels saved before it existed
 		}
 
 		if (data[5] == 0xFF)
@@ -305,6 +373,7 @@ void RADIO_ConfigureChannel(const unsigned int VFO, const unsigned int configure
 			pVfo->DTMF_DECODING_ENABLE = false;
 #endif
 			pVfo->DTMF_PTT_ID_TX_MODE  = PTT_ID_OFF;
+			pVfo->TAIL_MODE            = TAIL_MODE_DEFAULT;
 		}
 		else
 		{
@@ -313,6 +382,8 @@ void RADIO_ConfigureChannel(const unsigned int VFO, const unsigned int configure
 #endif
 			uint8_t pttId = ((data[5] >> 1) & 7u);
 			pVfo->DTMF_PTT_ID_TX_MODE  = pttId < ARRAY_SIZE(gSubMenu_PTT_ID) ? pttId : PTT_ID_OFF;
+			uint8_t tailMode = ((data[5] >> 4) & 7u);
+			pVfo->TAIL_MODE            = tailMode <= TAIL_MODE_LAST ? tailMode : TAIL_MODE_DEFAULT;
 		}
 
 		// ***************
@@ -389,98 +460,32 @@ void RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo)
 
 
 	// *******************************
-	// squelch
+	// squelch, from the table SETTINGS_LoadCalibration() made
 
-	FREQUENCY_Band_t Band = FREQUENCY_GetBand(pInfo->pRX->Frequency);
-	uint16_t Base = (Band < BAND4_174MHz) ? 0x1E60 : 0x1E00;
+	const FREQUENCY_Band_t     Band = FREQUENCY_GetBand(pInfo->pRX->Frequency);
+	const SquelchThresholds_t *pSq  = &gSquelchThresholds[Band >= BAND4_174MHz][(gEeprom.SQUELCH_LEVEL < 10) ? gEeprom.SQUELCH_LEVEL : 9];
 
-	if (gEeprom.SQUELCH_LEVEL == 0)
-	{	// squelch == 0 (off)
-		pInfo->SquelchOpenRSSIThresh    = 0;     // 0 ~ 255
-		pInfo->SquelchOpenNoiseThresh   = 127;   // 127 ~ 0
-		pInfo->SquelchCloseGlitchThresh = 255;   // 255 ~ 0
-
-		pInfo->SquelchCloseRSSIThresh   = 0;     // 0 ~ 255
-		pInfo->SquelchCloseNoiseThresh  = 127;   // 127 ~ 0
-		pInfo->SquelchOpenGlitchThresh  = 255;   // 255 ~ 0
-	}
-	else
-	{	// squelch >= 1
-		Base += gEeprom.SQUELCH_LEVEL;                                        // my eeprom squelch-1
-																			  // VHF   UHF
-		EEPROM_ReadBuffer(Base + 0x00, &pInfo->SquelchOpenRSSIThresh,    1);  //  50    10
-		EEPROM_ReadBuffer(Base + 0x10, &pInfo->SquelchCloseRSSIThresh,   1);  //  40     5
-
-		EEPROM_ReadBuffer(Base + 0x20, &pInfo->SquelchOpenNoiseThresh,   1);  //  65    90
-		EEPROM_ReadBuffer(Base + 0x30, &pInfo->SquelchCloseNoiseThresh,  1);  //  70   100
-
-		EEPROM_ReadBuffer(Base + 0x40, &pInfo->SquelchCloseGlitchThresh, 1);  //  90    90
-		EEPROM_ReadBuffer(Base + 0x50, &pInfo->SquelchOpenGlitchThresh,  1);  // 100   100
-
-
-		uint16_t noise_open   = pInfo->SquelchOpenNoiseThresh;
-		uint16_t noise_close  = pInfo->SquelchCloseNoiseThresh;
-
-#if ENABLE_SQUELCH_MORE_SENSITIVE
-		uint16_t rssi_open    = pInfo->SquelchOpenRSSIThresh;
-		uint16_t rssi_close   = pInfo->SquelchCloseRSSIThresh;
-		uint16_t glitch_open  = pInfo->SquelchOpenGlitchThresh;
-		uint16_t glitch_close = pInfo->SquelchCloseGlitchThresh;
-		// make squelch more sensitive
-		// note that 'noise' and 'glitch' values are inverted compared to 'rssi' values
-		rssi_open   = (rssi_open   * 1) / 2;
-		noise_open  = (noise_open  * 2) / 1;
-		glitch_open = (glitch_open * 2) / 1;
-
-		// ensure the 'close' threshold is lower than the 'open' threshold
-		if (rssi_close == rssi_open && rssi_close >= 2)
-			rssi_close -= 2;
-		if (noise_close == noise_open && noise_close  <= 125)
-			noise_close += 2;
-		if (glitch_close == glitch_open && glitch_close <= 253)
-			glitch_close += 2;
-
-		pInfo->SquelchOpenRSSIThresh    = (rssi_open    > 255) ? 255 : rssi_open;
-		pInfo->SquelchCloseRSSIThresh   = (rssi_close   > 255) ? 255 : rssi_close;
-		pInfo->SquelchOpenGlitchThresh  = (glitch_open  > 255) ? 255 : glitch_open;
-		pInfo->SquelchCloseGlitchThresh = (glitch_close > 255) ? 255 : glitch_close;
-#endif
-
-		pInfo->SquelchOpenNoiseThresh   = (noise_open   > 127) ? 127 : noise_open;
-		pInfo->SquelchCloseNoiseThresh  = (noise_close  > 127) ? 127 : noise_close;
-	}
+	pInfo->SquelchOpenRSSIThresh    = pSq->OpenRSSI;
+	pInfo->SquelchCloseRSSIThresh   = pSq->CloseRSSI;
+	pInfo->SquelchOpenNoiseThresh   = pSq->OpenNoise;
+	pInfo->SquelchCloseNoiseThresh  = pSq->CloseNoise;
+	pInfo->SquelchCloseGlitchThresh = pSq->CloseGlitch;
+	pInfo->SquelchOpenGlitchThresh  = pSq->OpenGlitch;
 
 	// *******************************
 	// output power
 
-	Band = FREQUENCY_GetBand(pInfo->pTX->Frequency);
-
-	uint8_t Txp[3];
-	EEPROM_ReadBuffer(0x1ED0 + (Band * 16) + (pInfo->OUTPUT_POWER * 3), Txp, 3);
-
-#ifdef ENABLE_REDUCE_LOW_MID_TX_POWER
-	// make low and mid even lower
-	if (pInfo->OUTPUT_POWER == OUTPUT_POWER_LOW) {
-		Txp[0] /= 5;
-		Txp[1] /= 5;
-		Txp[2] /= 5;
-	}
-	else if (pInfo->OUTPUT_POWER == OUTPUT_POWER_MID){
-		Txp[0] /= 3;
-		Txp[1] /= 3;
-		Txp[2] /= 3;
-	}
-#endif
-
-	pInfo->TXP_CalculatedSetting = FREQUENCY_CalculateOutputPower(
-		Txp[0],
-		Txp[1],
-		Txp[2],
-		 frequencyBandTable[Band].lower,
-		(frequencyBandTable[Band].lower + frequencyBandTable[Band].upper) / 2,
-		 frequencyBandTable[Band].upper,
+	// from the table SETTINGS_LoadCalibration() made
+	pInfo->TXP_CalculatedSetting = FREQUENCY_GetOutputPower(
+		FREQUENCY_GetBand(pInfo->pTX->Frequency),
+		pInfo->OUTPUT_POWER,
 		pInfo->pTX->Frequency);
 
+	// only the VFO that'll transmit, and not on every scan hop, anything
+	// else gets it from RADIO_SetTxParameters() at PTT
+	if (pInfo == gTxVfo && gScanStateDir == SCAN_OFF)
+		ComputeTxSetup(pInfo);
+
 	// *******************************
 }
 
@@ -520,6 +525,10 @@ void RADIO_SelectVfos(void)
 	gTxVfo = &gEeprom.VfoInfo[gEeprom.TX_VFO];
 	gRxVfo = &gEeprom.VfoInfo[gEeprom.RX_VFO];
 
+	// the TX VFO may have changed, have its TX registers ready for PTT
+	if (gScanStateDir == SCAN_OFF && !TxSetupValid(gTxVfo))
+		ComputeTxSetup(gTxVfo);
+
 	RADIO_SelectCurrentVfo();
 }
 
@@ -527,6 +536,8 @@ void RADIO_SetupRegisters(bool switchToForeground)
 {
 	BK4819_FilterBandwidth_t Bandwidth = gRxVfo->CHANNEL_BANDWIDTH;
 
+	AUDIO_SeqFinish();
+
 	AUDIO_AudioPathOff();
 
 	gEnableSpeaker = false;
@@ -615,24 +626,14 @@ void RADIO_SetupRegisters(bool switchToForeground)
 				default:
 				case CODE_TYPE_OFF:
 					BK4819_SetCTCSSFrequency(670);
-
-					//#ifndef ENABLE_CTCSS_TAIL_PHASE_SHIFT
-						BK4819_SetTailDetection(550);		// QS's 55Hz tone method
-					//#else
-					//	BK4819_SetTailDetection(670);       // 67Hz
-					//#endif
+					TAIL_SetupRx(CodeType, Code);
 
 					InterruptMask = BK4819_REG_3F_CxCSS_TAIL | BK4819_REG_3F_SQUELCH_FOUND | BK4819_REG_3F_SQUELCH_LOST;
 					break;
 
 				case CODE_TYPE_CONTINUOUS_TONE:
 					BK4819_SetCTCSSFrequency(CTCSS_Options[Code]);
-
-					//#ifndef ENABLE_CTCSS_TAIL_PHASE_SHIFT
-						BK4819_SetTailDetection(550);		// QS's 55Hz tone method
-					//#else
-					//	BK4819_SetTailDetection(CTCSS_Options[Code]);
-					//#endif
+					TAIL_SetupRx(CodeType, Code);
 
 					InterruptMask = 0
 						| BK4819_REG_3F_CxCSS_TAIL
@@ -683,12 +684,20 @@ void RADIO_SetupRegisters(bool switchToForeground)
 #endif
 	){
 		BK4819_EnableVox(gEeprom.VOX1_THRESHOLD, gEeprom.VOX0_THRESHOLD);
+#ifdef ENABLE_SW_VOX
+		// the mic level's still measured, the chip's own decision isn't used
+		VOX_Start(gEeprom.VOX1_THRESHOLD, gEeprom.VOX0_THRESHOLD);
+#else
 		InterruptMask |= BK4819_REG_3F_VOX_FOUND | BK4819_REG_3F_VOX_LOST;
+#endif
 	}
 	else
 #endif
 	{
 		BK4819_DisableVox();
+#ifdef ENABLE_SW_VOX
+		VOX_Stop();
+#endif
 	}
 
 	// RX expander
@@ -697,7 +706,7 @@ void RADIO_SetupRegisters(bool switchToForeground)
 	BK4819_EnableDTMF();
 	InterruptMask |= BK4819_REG_3F_DTMF_5TONE_FOUND;
 
-	RADIO_SetupAGC(gRxVfo->Modulation == MODULATION_AM, false);
+	RADIO_SetupAGC(gRxVfo->Modulation, false);
 
 	// enable/disable BK4819 selected interrupts
 	BK4819_WriteRegister(BK4819_REG_3F, InterruptMask);
@@ -755,7 +764,10 @@ void RADIO_SetupRegisters(bool switchToForeground)
 
 void RADIO_SetTxParameters(void)
 {
-	BK4819_FilterBandwidth_t Bandwidth = gCurrentVfo->CHANNEL_BANDWIDTH;
+	if (!TxSetupValid(gCurrentVfo))
+		ComputeTxSetup(gCurrentVfo);
+
+	const RADIO_TxSetup_t *pSetup = &gCurrentVfo->TxSetup;
 
 	AUDIO_AudioPathOff();
 
@@ -763,23 +775,9 @@ void RADIO_SetTxParameters(void)
 
 	BK4819_ToggleGpioOut(BK4819_GPIO0_PIN28_RX_ENABLE, false);
 
-	switch (Bandwidth)
-	{
-		default:
-			Bandwidth = BK4819_FILTER_BW_WIDE;
-			[[fallthrough]];
-		case BK4819_FILTER_BW_WIDE:
-		case BK4819_FILTER_BW_NARROW:
-			#ifdef ENABLE_AM_FIX
-//				BK4819_SetFilterBandwidth(Bandwidth, gCurrentVfo->Modulation == MODULATION_AM && gSetting_AM_fix);
-				BK4819_SetFilterBandwidth(Bandwidth, true);
-			#else
-				BK4819_SetFilterBandwidth(Bandwidth, false);
-			#endif
-			break;
-	}
+	BK4819_WriteRegister(BK4819_REG_43, pSetup->FilterReg);
 
-	BK4819_SetFrequency(gCurrentVfo->pTX->Frequency);
+	BK4819_SetFrequency(pSetup->Frequency);
 
 	// TX compressor
 	BK4819_SetCompander((gRxVfo->Modulation == MODULATION_FM && (gRxVfo->Compander == 1 || gRxVfo->Compander >= 3)) ? gRxVfo->Compander : 0);
@@ -788,17 +786,22 @@ void RADIO_SetTxParameters(void)
 
 	SYSTEM_DelayMs(10);
 
-	BK4819_PickRXFilterPathBasedOnFrequency(gCurrentVfo->pTX->Frequency);
+	BK4819_PickRXFilterPathBasedOnFrequency(pSetup->Frequency);
 
 	BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, true);
 
 	SYSTEM_DelayMs(5);
 
-	BK4819_SetupPowerAmplifier(gCurrentVfo->TXP_CalculatedSetting, gCurrentVfo->pTX->Frequency);
+	BK4819_WriteRegister(BK4819_REG_36, pSetup->PowerReg);
+
+	if (txTiming) {
+		gTxSetup_us = SYSTICK_GetUs() - txStart_us;
+		txTiming    = false;
+	}
 
 	SYSTEM_DelayMs(10);
 
-	switch (gCurrentVfo->pTX->CodeType)
+	switch (pSetup->CodeType)
 	{
 		default:
 		case CODE_TYPE_OFF:
@@ -806,12 +809,12 @@ void RADIO_SetTxParameters(void)
 			break;
 
 		case CODE_TYPE_CONTINUOUS_TONE:
-			BK4819_SetCTCSSFrequency(CTCSS_Options[gCurrentVfo->pTX->Code]);
+			BK4819_SetCTCSSFrequency(pSetup->SubAudio);
 			break;
 
 		case CODE_TYPE_DIGITAL:
 		case CODE_TYPE_REVERSE_DIGITAL:
-			BK4819_SetCDCSSCodeWord(DCS_GetGolayCodeWord(gCurrentVfo->pTX->CodeType, gCurrentVfo->pTX->Code));
+			BK4819_SetCDCSSCodeWord(pSetup->SubAudio);
 			break;
 	}
 }
@@ -847,35 +850,87 @@ void RADIO_SetModulation(ModulationMode_t modulation)
 	BK4819_WriteRegister(BK4819_REG_3D, modulation == MODULATION_USB ? 0 : 0x2AAB);
 	BK4819_SetRegValue(afcDisableRegSpec, modulation != MODULATION_FM);
 
-	RADIO_SetupAGC(modulation == MODULATION_AM, false);
+	RADIO_SetupAGC(modulation, false);
+}
+
+const int8_t dBmCorrTable[7] = {
+			-15, // band 1
+			-25, // band 2
+			-20, // band 3
+			-4, // band 4
+			-7, // band 5
+			-6, // band 6
+			 -1  // band 7
+		};
+
+static uint16_t rssiCache;
+// AM fix gain reduction in effect when rssiCache was read, AM fix may change
+// the gain later on in the same tick
+static int8_t   rssiCacheGainDiff;
+
+uint16_t RADIO_GetRawRssi(void)
+{	// one REG_67 read per 10ms tick, no matter how many want it
+	if (gRssiCacheExpired) {
+		gRssiCacheExpired = false;
+		rssiCache         = BK4819_GetRSSI();
+#ifdef ENABLE_AM_FIX
+		rssiCacheGainDiff = AM_fix_get_gain_diff();
+#endif
+	}
+	return rssiCache;
+}
+
+static uint16_t CompensateRssi(uint16_t rssi, bool softAGC, int8_t gainDiff, uint8_t band)
+{
+	int16_t dB = dBmCorrTable[band];
+	if (softAGC)
+		dB += gainDiff;   // add back the gain AM fix took away
+	const int16_t compensated = rssi + dB * 2;
+	return (compensated < 0) ? 0 : compensated;
+}
+
+// the RSSI as every consumer (display, spectrum, UART) should see it, with
+// the AM fix gain reduction added back in and the per band correction applied
+uint16_t RADIO_CompensateRssi(uint16_t rssi, ModulationMode_t modulation, uint8_t band)
+{
+#ifdef ENABLE_AM_FIX
+	return CompensateRssi(rssi, AM_fix_active(modulation), AM_fix_get_gain_diff(), band);
+#else
+	(void)modulation;
+	return CompensateRssi(rssi, false, 0, band);
+#endif
+}
+
+uint16_t RADIO_GetCompensatedRssi(void)
+{
+	const uint16_t rssi = RADIO_GetRawRssi();
+#ifdef ENABLE_AM_FIX
+	return CompensateRssi(rssi, AM_fix_active(gRxVfo->Modulation), rssiCacheGainDiff, gRxVfo->Band);
+#else
+	return CompensateRssi(rssi, false, 0, gRxVfo->Band);
+#endif
 }
 
-void RADIO_SetupAGC(bool listeningAM, bool disable)
+// MODULATION_UKNOWN = not listening, leave it to the BK4819's own AGC
+void RADIO_SetupAGC(ModulationMode_t modulation, bool disable)
 {
-	static uint8_t lastSettings;
-	uint8_t newSettings = (listeningAM << 1) | (disable << 1);
+	static uint8_t lastSettings = 0xFF;
+	uint8_t newSettings = (modulation << 1) | disable;
 	if(lastSettings == newSettings)
 		return;
 	lastSettings = newSettings;
 
-
-	if(!listeningAM) { // if not actively listening AM we don't need any AM specific regulation
-		BK4819_SetAGC(!disable);
-		BK4819_InitAGC(false);
-	}
-	else {
 #ifdef ENABLE_AM_FIX
-		if(gSetting_AM_fix) { // if AM fix active lock AGC so AM-fix can do it's job
-			BK4819_SetAGC(0);
-			AM_fix_enable(!disable);
-		}
-		else
-#endif
-		{
-			BK4819_SetAGC(!disable);
-			BK4819_InitAGC(true);
-		}
+	if(AM_fix_active(modulation)) { // if AM fix (software AGC) active lock AGC so AM-fix can do it's job
+		BK4819_SetAGC(0);
+		AM_fix_enable(!disable);
+		return;
 	}
+#endif
+
+	// only AM needs AM specific regulation
+	BK4819_SetAGC(!disable);
+	BK4819_InitAGC(modulation == MODULATION_AM);
 }
 
 void RADIO_SetVfoState(VfoState_t State)
@@ -901,6 +956,9 @@ void RADIO_PrepareTX(void)
 {
 	VfoState_t State = VFO_STATE_NORMAL;  // default to OK to TX
 
+	txStart_us = SYSTICK_GetUs();
+	txTiming   = true;
+
 	if (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF)
 	{	// dual-RX is enabled
 
@@ -950,6 +1008,7 @@ void RADIO_PrepareTX(void)
 
 	if (State != VFO_STATE_NORMAL) {
 		// TX not allowed
+		txTiming = false;
 		RADIO_SetVfoState(State);
 
 #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
@@ -1004,30 +1063,48 @@ void RADIO_PrepareTX(void)
 #endif
 }
 
-void RADIO_SendCssTail(void)
+static void StartRogerMDC(uint16_t unused)
 {
-	switch (gCurrentVfo->pTX->CodeType) {
-	case CODE_TYPE_DIGITAL:
-	case CODE_TYPE_REVERSE_DIGITAL:
-		BK4819_PlayCDCSSTail();
-		break;
-	default:
-		BK4819_PlayCTCSSTail();
-		break;
-	}
+	(void)unused;
+	BK4819_StartRogerMDC();
+}
 
-	SYSTEM_DelayMs(200);
+static void SendRogerMDC(uint16_t unused)
+{
+	(void)unused;
+	BK4819_SendRogerMDC();
+}
+
+static void StopRogerMDC(uint16_t unused)
+{
+	(void)unused;
+	BK4819_StopRogerMDC();
+}
+
+static void SetupRxRegisters(uint16_t unused)
+{
+	(void)unused;
+	RADIO_SetupRegisters(false);
 }
 
 void RADIO_SendEndOfTransmission(void)
 {
-	BK4819_PlayRoger();
+	// queued, the caller goes back to RX once AUDIO_SeqBusy() says it's done
+	if (gEeprom.ROGER == ROGER_MODE_ROGER) {
+		// motorola type
+		AUDIO_SeqTwoTone(1540, 1310, 80, 66, true);
+	}
+	else if (gEeprom.ROGER == ROGER_MODE_MDC) {
+		AUDIO_SeqAdd(StartRogerMDC, 0, 20);
+		AUDIO_SeqAdd(SendRogerMDC, 0, 180);
+		AUDIO_SeqAdd(StopRogerMDC, 0, 0);
+	}
+
 	DTMF_SendEndOfTransmission();
 
-	// send the CTCSS/DCS tail tone - allows the receivers to mute the usual FM squelch tail/crash
-	if(gEeprom.TAIL_TONE_ELIMINATION)
-		RADIO_SendCssTail();
-	RADIO_SetupRegisters(false);
+	// send the CTCSS/DCS tail tone
+	TAIL_QueueTx();
+	AUDIO_SeqAdd(SetupRxRegisters, 0, 0);
 }
 
 void RADIO_PrepareCssTX(void)
@@ -1036,7 +1113,6 @@ void RADIO_PrepareCssTX(void)
 
 	SYSTEM_DelayMs(200);
 
-	if(gEeprom.TAIL_TONE_ELIMINATION)
-		RADIO_SendCssTail();
+	TAIL_SendTx();
 	RADIO_SetupRegisters(true);
 }
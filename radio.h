@@ -69,6 +69,7 @@ typedef enum {
 } ModulationMode_t;
 
 extern const char gModulationStr[MODULATION_UKNOWN][4];
+extern const int8_t dBmCorrTable[7];
 
 typedef struct
 {
@@ -78,6 +79,20 @@ typedef struct
 	uint8_t        Padding[2];
 } FREQ_Config_t;
 
+// what RADIO_SetTxParameters() writes to the BK4819, worked out along with
+// TXP_CalculatedSetting when the VFO's configured rather than after PTT
+typedef struct
+{
+	uint32_t       Frequency;       // TX frequency it was worked out for
+	uint32_t       SubAudio;        // CTCSS frequency control word or DCS Golay code word
+	uint16_t       FilterReg;       // REG_43
+	uint16_t       PowerReg;        // REG_36, PA bias and gain
+	uint8_t        Bandwidth;       // and what it was worked out from
+	uint8_t        TXP;
+	uint8_t        CodeType;
+	uint8_t        Code;
+} RADIO_TxSetup_t;
+
 typedef struct VFO_Info_t
 {
 	FREQ_Config_t  freq_config_RX;
@@ -129,7 +144,12 @@ typedef struct VFO_Info_t
 
 	uint8_t        Compander;
 
+	uint8_t        TAIL_MODE;    // TAIL_Mode_t
+	uint8_t        TAIL_TIME;    // *100ms, 1 to TAIL_TIME_MAX
+
 	char           Name[16];
+
+	RADIO_TxSetup_t TxSetup;
 } VFO_Info_t;
 
 // Settings of the main VFO that is selected by the user
@@ -148,6 +168,9 @@ extern DCS_CodeType_t gCurrentCodeType;
 
 extern VfoState_t     VfoState[2];
 
+// RADIO_PrepareTX() to the PA being switched on, last time round
+extern uint32_t       gTxSetup_us;
+
 bool     RADIO_CheckValidChannel(uint16_t channel, bool checkScanList, uint8_t scanList);
 uint8_t  RADIO_FindNextChannel(uint8_t ChNum, int8_t Direction, bool bCheckScanList, uint8_t RadioNum);
 void     RADIO_InitInfo(VFO_Info_t *pInfo, const uint8_t ChannelSave, const uint32_t Frequency);
@@ -160,11 +183,14 @@ void     RADIO_SetupRegisters(bool switchToForeground);
 	void RADIO_ConfigureNOAA(void);
 #endif
 void     RADIO_SetTxParameters(void);
-void 	 RADIO_SetupAGC(bool listeningAM, bool disable);
+void 	 RADIO_SetupAGC(ModulationMode_t modulation, bool disable);
+// RSSI in BK4819 units (0.5dB, dBm = (rssi / 2) - 160)
+uint16_t RADIO_GetRawRssi(void);
+uint16_t RADIO_CompensateRssi(uint16_t rssi, ModulationMode_t modulation, uint8_t band);
+uint16_t RADIO_GetCompensatedRssi(void);
 void     RADIO_SetModulation(ModulationMode_t modulation);
 void     RADIO_SetVfoState(VfoState_t State);
 void     RADIO_PrepareTX(void);
-void     RADIO_SendCssTail(void);
 void     RADIO_PrepareCssTX(void);
 void     RADIO_SendEndOfTransmission(void);
 
@@ -20,6 +20,7 @@
 #endif
 #include "app/scanner.h"
 #include "audio.h"
+#include "driver/bk4819.h"
 #include "functions.h"
 #include "helper/battery.h"
 #include "misc.h"
@@ -42,8 +43,6 @@
 				flag = true;             \
 	} while (0)
 
-static volatile uint32_t gGlobalSysTickCounter;
-
 void SystickHandler(void);
 
 // we come here every 10ms
@@ -52,6 +51,7 @@ void SystickHandler(void)
 	gGlobalSysTickCounter++;
 	
 	gNextTimeslice = true;
+	gRssiCacheExpired = true;
 
 	if ((gGlobalSysTickCounter % 50) == 0) {
 		gNextTimeslice_500ms = true;
@@ -63,6 +63,10 @@ void SystickHandler(void)
 	if ((gGlobalSysTickCounter & 3) == 0)
 		gNextTimeslice40ms = true;
 
+#ifdef ENABLE_BACKLIGHT_FADE
+	BACKLIGHT_FadeTick();
+#endif
+
 #ifdef ENABLE_NOAA
 	DECREMENT(gNOAACountdown_10ms);
 #endif
@@ -77,6 +81,13 @@ void SystickHandler(void)
 	if (gCurrentFunction == FUNCTION_POWER_SAVE)
 		DECREMENT_AND_TRIGGER(gPowerSave_10ms, gPowerSaveCountdownExpired);
 
+	gPowerSaveStats.ticks++;
+	if (gCurrentFunction == FUNCTION_POWER_SAVE) {
+		gPowerSaveStats.power_save_ticks++;
+		if (gRxIdleMode)
+			gPowerSaveStats.rx_off_ticks++;
+	}
+
 	if (gScanStateDir == SCAN_OFF && !gCssBackgroundScan && gEeprom.DUAL_WATCH != DUAL_WATCH_OFF)
 		if (gCurrentFunction != FUNCTION_MONITOR && gCurrentFunction != FUNCTION_TRANSMIT && gCurrentFunction != FUNCTION_RECEIVE)
 			DECREMENT_AND_TRIGGER(gDualWatchCountdown_10ms, gScheduleDualWatch);
@@ -94,6 +105,10 @@ void SystickHandler(void)
 
 	DECREMENT_AND_TRIGGER(gTailToneEliminationCountdown_10ms, gFlagTailToneEliminationComplete);
 
+#ifdef ENABLE_DEFERRED_SAVES
+	DECREMENT_AND_TRIGGER(gEepromWriteCountdown_10ms, gScheduleEepromWrite);
+#endif
+
 #ifdef ENABLE_VOICE
 	DECREMENT_AND_TRIGGER(gCountdownToPlayNextVoice_10ms, gFlagPlayQueuedVoice);
 #endif
@@ -17,14 +17,21 @@
 #include <string.h>
 
 #include "app/dtmf.h"
+#ifdef ENABLE_CHANNEL_BANKS
+	#include "channel_bank.h"
+#endif
 #ifdef ENABLE_FMRADIO
 	#include "app/fm.h"
 #endif
 #include "driver/bk1080.h"
 #include "driver/bk4819.h"
 #include "driver/eeprom.h"
+#include "frequencies.h"
+#include "key_queue.h"
 #include "misc.h"
+#include "name_index.h"
 #include "settings.h"
+#include "settings_journal.h"
 #include "ui/menu.h"
 
 static const uint32_t gDefaultFrequencyTable[] =
@@ -72,7 +79,10 @@ void SETTINGS_InitEEPROM(void)
 	gEeprom.VFO_OPEN              = (Data[7] < 2) ? Data[7] : true;
 
 	// 0E80..0E87
-	EEPROM_ReadBuffer(0x0E80, Data, 8);
+	#ifdef ENABLE_SETTINGS_JOURNAL
+		if (!JOURNAL_Load(Data))
+	#endif
+			EEPROM_ReadBuffer(0x0E80, Data, 8);
 	gEeprom.ScreenChannel[0]   = IS_VALID_CHANNEL(Data[0]) ? Data[0] : (FREQ_CHANNEL_FIRST + BAND6_400MHz);
 	gEeprom.ScreenChannel[1]   = IS_VALID_CHANNEL(Data[3]) ? Data[3] : (FREQ_CHANNEL_FIRST + BAND6_400MHz);
 	gEeprom.MrChannel[0]       = IS_MR_CHANNEL(Data[1])    ? Data[1] : MR_CHANNEL_FIRST;
@@ -152,6 +162,9 @@ void SETTINGS_InitEEPROM(void)
 	gEeprom.REPEATER_TAIL_TONE_ELIMINATION = (Data[2] < 11) ? Data[2] : 0;
 	gEeprom.TX_VFO                         = (Data[3] <  2) ? Data[3] : 0;
 	gEeprom.BATTERY_TYPE                   = (Data[4] < BATTERY_TYPE_UNKNOWN) ? Data[4] : BATTERY_TYPE_1600_MAH;
+	gKeyTiming.long_press_10ms             = (Data[5] >= 30 && Data[5] <= 150) ? Data[5] : KEYQ_LONG_PRESS_DEFAULT;
+	gKeyTiming.repeat_10ms                 = (Data[6] >=  4 && Data[6] <=  25) ? Data[6] : KEYQ_REPEAT_DEFAULT;
+	gKeyTiming.debounce_10ms               = (Data[7] >=  1 && Data[7] <=  10) ? Data[7] : KEYQ_DEBOUNCE_DEFAULT;
 
 	// 0ED0..0ED7
 	EEPROM_ReadBuffer(0x0ED0, Data, 8);
@@ -300,6 +313,71 @@ void SETTINGS_LoadCalibration(void)
 	}
 	gBatteryCalibration[5] = 2300;
 
+	// squelch, VHF at 0x1E60 and UHF at 0x1E00, a row of 16 per threshold indexed by level
+	for (unsigned int uhf = 0; uhf < 2; uhf++) {
+		uint8_t Row[6][16];
+
+		EEPROM_ReadBuffer(uhf ? 0x1E00 : 0x1E60, Row, sizeof(Row));
+
+		// squelch == 0 (off)
+		gSquelchThresholds[uhf][0] = (SquelchThresholds_t){
+			.OpenRSSI    = 0,   .CloseRSSI   = 0,
+			.OpenNoise   = 127, .CloseNoise  = 127,
+			.CloseGlitch = 255, .OpenGlitch  = 255,
+		};
+
+		for (unsigned int level = 1; level < 10; level++) {
+			SquelchThresholds_t *pSq = &gSquelchThresholds[uhf][level];
+			                                          // VHF   UHF
+			uint16_t rssi_open    = Row[0][level];    //  50    10
+			uint16_t rssi_close   = Row[1][level];    //  40     5
+			uint16_t noise_open   = Row[2][level];    //  65    90
+			uint16_t noise_close  = Row[3][level];    //  70   100
+			uint16_t glitch_close = Row[4][level];    //  90    90
+			uint16_t glitch_open  = Row[5][level];    // 100   100
+
+#if ENABLE_SQUELCH_MORE_SENSITIVE
+			// make squelch more sensitive
+			// note that 'noise' and 'glitch' values are inverted compared to 'rssi' values
+			rssi_open   = (rssi_open   * 1) / 2;
+			noise_open  = (noise_open  * 2) / 1;
+			glitch_open = (glitch_open * 2) / 1;
+
+			// ensure the 'close' threshold is lower than the 'open' threshold
+			if (rssi_close == rssi_open && rssi_close >= 2)
+				rssi_close -= 2;
+			if (noise_close == noise_open && noise_close  <= 125)
+				noise_close += 2;
+			if (glitch_close == glitch_open && glitch_close <= 253)
+				glitch_close += 2;
+#endif
+
+			pSq->OpenRSSI    = (rssi_open    > 255) ? 255 : rssi_open;
+			pSq->CloseRSSI   = (rssi_close   > 255) ? 255 : rssi_close;
+			pSq->OpenNoise   = (noise_open   > 127) ? 127 : noise_open;
+			pSq->CloseNoise  = (noise_close  > 127) ? 127 : noise_close;
+			pSq->CloseGlitch = (glitch_close > 255) ? 255 : glitch_close;
+			pSq->OpenGlitch  = (glitch_open  > 255) ? 255 : glitch_open;
+		}
+	}
+
+	// TX power, 16 bytes a band, low/mid/high at the bottom, middle and top of it for each power setting
+	for (unsigned int band = 0; band < BAND_N_ELEM; band++) {
+		uint8_t Txp[OUTPUT_POWER_HIGH + 1][3];
+
+		EEPROM_ReadBuffer(0x1ED0 + (band * 16), Txp, sizeof(Txp));
+
+		for (unsigned int power = 0; power <= OUTPUT_POWER_HIGH; power++) {
+#ifdef ENABLE_REDUCE_LOW_MID_TX_POWER
+			// make low and mid even lower
+			const uint8_t div = (power == OUTPUT_POWER_LOW) ? 5 : (power == OUTPUT_POWER_MID) ? 3 : 1;
+			for (unsigned int i = 0; i < 3; i++)
+				Txp[power][i] /= div;
+#endif
+			FREQUENCY_SetOutputPowerCalibration(band, power, Txp[power]);
+		}
+	}
+
 	#ifdef ENABLE_VOX
 		EEPROM_ReadBuffer(0x1F50 + (gEeprom.VOX_LEVEL * 2), &gEeprom.VOX1_THRESHOLD, 2);
 		EEPROM_ReadBuffer(0x1F68 + (gEeprom.VOX_LEVEL * 2), &gEeprom.VOX0_THRESHOLD, 2);
@@ -402,6 +480,22 @@ void SETTINGS_FactoryReset(bool bIsAll)
 		}
 	}
 
+	#ifdef ENABLE_CHANNEL_BANKS
+		// blank channels, the bank they came from keeps its copy
+		if (bIsAll)
+			CHBANK_Forget();
+	#endif
+
+	#ifdef ENABLE_SETTINGS_JOURNAL
+		// the journal's copy of the VFO indices would outlive the reset
+		JOURNAL_Import();
+	#endif
+
+	#ifdef ENABLE_DEFERRED_SAVES
+		// a reboot follows
+		EEPROM_Flush();
+	#endif
+
 	if (bIsAll)
 	{
 		RADIO_InitInfo(gRxVfo, FREQ_CHANNEL_FIRST + BAND6_400MHz, 43350000);
@@ -450,7 +544,10 @@ void SETTINGS_SaveVfoIndices(void)
 	uint8_t State[8];
 
 	#ifndef ENABLE_NOAA
-		EEPROM_ReadBuffer(0x0E80, State, sizeof(State));
+		#ifdef ENABLE_SETTINGS_JOURNAL
+			if (!JOURNAL_Load(State))
+		#endif
+				EEPROM_ReadBuffer(0x0E80, State, sizeof(State));
 	#endif
 
 	State[0] = gEeprom.ScreenChannel[0];
@@ -464,7 +561,13 @@ void SETTINGS_SaveVfoIndices(void)
 		State[7] = gEeprom.NoaaChannel[1];
 	#endif
 
-	EEPROM_WriteBuffer(0x0E80, State);
+	#if defined(ENABLE_SETTINGS_JOURNAL)
+		JOURNAL_Save(State);
+	#elif defined(ENABLE_DEFERRED_SAVES)
+		EEPROM_WriteBufferDeferred(0x0E80, State);
+	#else
+		EEPROM_WriteBuffer(0x0E80, State);
+	#endif
 }
 
 void SETTINGS_SaveSettings(void)
@@ -538,6 +641,9 @@ void SETTINGS_SaveSettings(void)
 	State[2] = gEeprom.REPEATER_TAIL_TONE_ELIMINATION;
 	State[3] = gEeprom.TX_VFO;
 	State[4] = gEeprom.BATTERY_TYPE;
+	State[5] = gKeyTiming.long_press_10ms;
+	State[6] = gKeyTiming.repeat_10ms;
+	State[7] = gKeyTiming.debounce_10ms;
 	EEPROM_WriteBuffer(0x0EA8, State);
 
 	State[0] = gEeprom.DTMF_SIDE_TONE;
@@ -594,6 +700,20 @@ void SETTINGS_SaveSettings(void)
 	EEPROM_WriteBuffer(0x0F40, State);
 }
 
+// a VFO gets saved on every tuning step, a memory only when something's stored to it
+static void WriteChannelBlock(const uint8_t Channel, const uint16_t Address, const void *pBuffer)
+{
+#ifdef ENABLE_DEFERRED_SAVES
+	if (IS_FREQ_CHANNEL(Channel)) {
+		EEPROM_WriteBufferDeferred(Address, pBuffer);
+		return;
+	}
+#else
+	(void)Channel;
+#endif
+	EEPROM_WriteBuffer(Address, pBuffer);
+}
+
 void SETTINGS_SaveChannel(uint8_t Channel, uint8_t VFO, const VFO_Info_t *pVFO, uint8_t Mode)
 {
 #ifdef ENABLE_NOAA
@@ -616,25 +736,27 @@ void SETTINGS_SaveChannel(uint8_t Channel, uint8_t VFO, const VFO_Info_t *pVFO,
 
 		State._32[0] = pVFO->freq_config_RX.Frequency;
 		State._32[1] = pVFO->TX_OFFSET_FREQUENCY;
-		EEPROM_WriteBuffer(OffsetVFO + 0, State._32);
+		WriteChannelBlock(Channel, OffsetVFO + 0, State._32);
 
 		State._8[0] =  pVFO->freq_config_RX.Code;
 		State._8[1] =  pVFO->freq_config_TX.Code;
 		State._8[2] = (pVFO->freq_config_TX.CodeType << 4) | pVFO->freq_config_RX.CodeType;
 		State._8[3] = (pVFO->Modulation << 4) | pVFO->TX_OFFSET_FREQUENCY_DIRECTION;
 		State._8[4] = 0
+			| ((pVFO->TAIL_TIME & 7u)  << 5)
 			| (pVFO->BUSY_CHANNEL_LOCK << 4)
 			| (pVFO->OUTPUT_POWER      << 2)
 			| (pVFO->CHANNEL_BANDWIDTH << 1)
 			| (pVFO->FrequencyReverse  << 0);
-		State._8[5] = ((pVFO->DTMF_PTT_ID_TX_MODE & 7u) << 1)
+		State._8[5] = ((pVFO->TAIL_MODE & 7u) << 4)
+			| ((pVFO->DTMF_PTT_ID_TX_MODE & 7u) << 1)
 #ifdef ENABLE_DTMF_CALLING
 			| ((pVFO->DTMF_DECODING_ENABLE & 1u) << 0)
 #endif
 		;
 		State._8[6] =  pVFO->STEP_SETTING;
 		State._8[7] =  pVFO->SCRAMBLING_TYPE;
-		EEPROM_WriteBuffer(OffsetVFO + 8, State._8);
+		WriteChannelBlock(Channel, OffsetVFO + 8, State._8);
 
 		SETTINGS_UpdateChannel(Channel, pVFO, true);
 
@@ -669,6 +791,10 @@ void SETTINGS_SaveChannelName(uint8_t channel, const char * name)
 	memcpy(buf, name, MIN(strlen(name), 10u));
 	EEPROM_WriteBuffer(0x0F50 + offset, buf);
 	EEPROM_WriteBuffer(0x0F58 + offset, buf + 8);
+
+	#ifdef ENABLE_CHANNEL_NAME_SEARCH
+		NAMEIDX_Update(channel, (const char *)buf);
+	#endif
 }
 
 void SETTINGS_UpdateChannel(uint8_t channel, const VFO_Info_t *pVFO, bool keep)
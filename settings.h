@@ -91,6 +91,8 @@ enum ACTION_OPT_t {
 	ACTION_OPT_SWITCH_DEMODUL,
 	ACTION_OPT_BLMIN_TMP_OFF, //BackLight Minimum Temporay OFF
 	ACTION_OPT_SPECTRUM,
+	ACTION_OPT_BL_NIGHT,      //BackLight night profile
+	ACTION_OPT_NAME_SEARCH,   //jump to a channel by name
 	ACTION_OPT_LEN
 };
 
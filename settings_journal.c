@@ -0,0 +1,138 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifdef ENABLE_SETTINGS_JOURNAL
+
+#include <assert.h>
+#include <string.h>
+
+#include "driver/crc.h"
+#include "driver/eeprom.h"
+#include "settings_journal.h"
+
+#define FIXED_ADDRESS      0x0E80
+
+typedef struct {
+	uint8_t  version;
+	uint8_t  unused;
+	uint16_t sequence;
+	uint8_t  state[8];     // as the 0x0E80 block
+	uint8_t  spare[2];
+	uint16_t crc;          // over all of the above
+} __attribute__((packed)) Record_t;
+
+static_assert(sizeof(Record_t) == 16);
+
+static Record_t newest;
+static uint8_t  slot;          // where newest is
+static bool     valid;
+static bool     scanned;
+
+static uint16_t RecordCrc(const Record_t *pRecord)
+{
+	return CRC_Calculate(pRecord, sizeof(*pRecord) - sizeof(pRecord->crc));
+}
+
+static void Scan(void)
+{
+	valid   = false;
+	scanned = true;
+
+	for (unsigned int i = 0; i < JOURNAL_SLOTS; i++) {
+		Record_t record;
+
+		EEPROM_ReadBuffer(JOURNAL_ADDRESS + (i * sizeof(record)), &record, sizeof(record));
+
+		if (record.version != JOURNAL_VERSION || record.crc != RecordCrc(&record))
+			continue;
+
+		// the sequence wraps, newer is the one less than half way round ahead
+		if (!valid || (int16_t)(record.sequence - newest.sequence) > 0) {
+			newest = record;
+			slot   = i;
+			valid  = true;
+		}
+	}
+}
+
+bool JOURNAL_Load(uint8_t State[8])
+{
+	if (!scanned)
+		Scan();
+
+	if (valid)
+		memcpy(State, newest.state, sizeof(newest.state));
+
+	return valid;
+}
+
+void JOURNAL_Save(const uint8_t State[8])
+{
+	if (!scanned)
+		Scan();
+
+	if (valid && memcmp(State, newest.state, sizeof(newest.state)) == 0)
+		return;
+
+	bool reuse = false;
+#ifdef ENABLE_DEFERRED_SAVES
+	// the last one hasn't gone out yet, it can just be replaced
+	reuse = valid && EEPROM_IsDeferred(JOURNAL_ADDRESS + (slot * sizeof(newest)) + 8);
+#endif
+
+	const uint16_t sequence = !valid ? 0 : reuse ? newest.sequence : newest.sequence + 1;
+
+	if (!reuse)
+		slot = valid ? (slot + 1) % JOURNAL_SLOTS : 0;
+
+	memset(&newest, 0xFF, sizeof(newest));
+	newest.version  = JOURNAL_VERSION;
+	newest.sequence = sequence;
+	memcpy(newest.state, State, sizeof(newest.state));
+	newest.crc      = RecordCrc(&newest);
+	valid           = true;
+
+	// one page write for the whole record (EEPROM_Flush() pairs the two
+	// deferred halves back up), a write cut short still leaves a bad CRC
+	const uint16_t address = JOURNAL_ADDRESS + (slot * sizeof(newest));
+#ifdef ENABLE_DEFERRED_SAVES
+	EEPROM_WriteBufferDeferred(address + 0, (const uint8_t *)&newest + 0);
+	EEPROM_WriteBufferDeferred(address + 8, (const uint8_t *)&newest + 8);
+#else
+	EEPROM_WriteBuffer16(address, &newest);
+#endif
+}
+
+void JOURNAL_Import(void)
+{
+	uint8_t State[8];
+
+	EEPROM_ReadBuffer(FIXED_ADDRESS, State, sizeof(State));
+
+	// appended after whatever's newest in there now
+	Scan();
+	JOURNAL_Save(State);
+}
+
+void JOURNAL_Export(void)
+{
+	uint8_t State[8];
+
+	if (JOURNAL_Load(State))
+		EEPROM_WriteBuffer(FIXED_ADDRESS, State);
+}
+
+#endif
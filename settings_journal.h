@@ -0,0 +1,49 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef SETTINGS_JOURNAL_H
+#define SETTINGS_JOURNAL_H
+
+#ifdef ENABLE_SETTINGS_JOURNAL
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// settings journal
+//
+// the VFO/channel indices (the 0x0E80 block) get saved on just about every
+// channel change, so rather than rewrite the same 8 bytes each time they
+// go in 16 byte records appended round a ring at 0x1D00..0x1DFF, each with
+// a sequence number and a CRC. At boot the newest record with a good CRC
+// wins, a record that was only half written when the power went is
+// skipped and the one before it used. That's 16 slots to spread the wear
+// over, and the fixed block is only brought up to date when a CPS reads it.
+
+#define JOURNAL_ADDRESS    0x1D00
+#define JOURNAL_SLOTS      16
+#define JOURNAL_VERSION    1
+
+// the newest copy of the 0x0E80 block, false if there's no valid record
+bool JOURNAL_Load(uint8_t State[8]);
+void JOURNAL_Save(const uint8_t State[8]);
+// a CPS wrote the 0x0E80 block (or the journal), take that as the newest
+void JOURNAL_Import(void);
+// and about to read it, copy the newest record back there
+void JOURNAL_Export(void);
+
+#endif
+
+#endif
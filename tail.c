@@ -0,0 +1,231 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "audio.h"
+#include "dcs.h"
+#include "driver/bk4819.h"
+#include "driver/system.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+#include "tail.h"
+
+#ifdef ENABLE_TAIL_STATS
+	#define NO_TICK  0xFFFF
+
+	TAIL_Stats_t gTAIL_Stats;
+
+	static uint16_t tick_10ms;
+
+	// the RX end currently being timed
+	static struct {
+		uint8_t  trigger;
+		uint16_t trigger_tick;
+		uint16_t mute_tick;
+		uint16_t close_tick;
+	} rx;
+#endif
+
+static TAIL_Mode_t ResolveMode(const TAIL_Mode_t Mode, const uint8_t CodeType)
+{
+	if (CodeType != CODE_TYPE_CONTINUOUS_TONE)
+		return TAIL_MODE_55HZ;   // no tone to shift the phase of
+
+	if (Mode == TAIL_MODE_DEFAULT) {
+		#ifdef ENABLE_CTCSS_TAIL_PHASE_SHIFT
+			return TAIL_MODE_180;
+		#else
+			return TAIL_MODE_55HZ;
+		#endif
+	}
+
+	return Mode;
+}
+
+static void StartTail(uint16_t unused)
+{
+	(void)unused;
+
+	const FREQ_Config_t *pConfig = gCurrentVfo->pTX;
+
+	switch (pConfig->CodeType) {
+	case CODE_TYPE_DIGITAL:
+	case CODE_TYPE_REVERSE_DIGITAL:
+		BK4819_PlayCDCSSTail();
+		break;
+
+	default:
+		switch (ResolveMode(gCurrentVfo->TAIL_MODE, pConfig->CodeType)) {
+		case TAIL_MODE_120: BK4819_PlayCTCSSTail(1); break;
+		case TAIL_MODE_180: BK4819_PlayCTCSSTail(2); break;
+		case TAIL_MODE_240: BK4819_PlayCTCSSTail(3); break;
+		default:            BK4819_PlayCTCSSTail(4); break;   // 55Hz tone
+		}
+		break;
+	}
+}
+
+void TAIL_QueueTx(void)
+{
+	// allows the receivers to mute the usual FM squelch tail/crash
+	if (gEeprom.TAIL_TONE_ELIMINATION)
+		AUDIO_SeqAdd(StartTail, 0, gCurrentVfo->TAIL_TIME * 100);
+}
+
+void TAIL_SendTx(void)
+{
+	if (!gEeprom.TAIL_TONE_ELIMINATION)
+		return;
+
+	StartTail(0);
+	SYSTEM_DelayMs(gCurrentVfo->TAIL_TIME * 100);
+}
+
+void TAIL_SetupRx(uint8_t CodeType, uint8_t Code)
+{
+	if (CodeType == CODE_TYPE_DIGITAL || CodeType == CODE_TYPE_REVERSE_DIGITAL)
+		return;   // 134.4Hz, the chip looks for that on its own
+
+	if (ResolveMode(gRxVfo->TAIL_MODE, CodeType) == TAIL_MODE_55HZ)
+		BK4819_SetTailDetection(550);                  // QS's 55Hz tone method
+	else
+		BK4819_SetTailDetection(CTCSS_Options[Code]);  // phase shift of our own tone
+}
+
+void TAIL_RxMute(void)
+{
+	AUDIO_AudioPathOff();
+
+	gTailToneEliminationCountdown_10ms = gRxVfo->TAIL_TIME * 10;
+	gFlagTailToneEliminationComplete   = false;
+	gEndOfRxDetectedMaybe              = true;
+	gEnableSpeaker                     = false;
+
+#ifdef ENABLE_TAIL_STATS
+	if (rx.trigger == TAIL_TRIGGER_NONE) {
+		// DCS turn off code, found by polling rather than an interrupt
+		rx.trigger      = TAIL_TRIGGER_TAIL;
+		rx.trigger_tick = tick_10ms;
+	}
+	if (rx.mute_tick == NO_TICK)
+		rx.mute_tick = tick_10ms;
+#endif
+}
+
+void TAIL_RxEnd(void)
+{
+#ifdef ENABLE_TAIL_STATS
+	if (rx.trigger == TAIL_TRIGGER_NONE) {
+		rx.trigger      = TAIL_TRIGGER_SQUELCH;
+		rx.trigger_tick = tick_10ms;
+	}
+
+	TAIL_Event_t *pEvent = &gTAIL_Stats.event[gTAIL_Stats.head];
+
+	pEvent->trigger    = rx.trigger;
+	pEvent->end        = (rx.mute_tick == NO_TICK) ? TAIL_END_PLAIN : TAIL_END_TTE;
+	pEvent->mode       = ResolveMode(gRxVfo->TAIL_MODE, gCurrentCodeType);
+	pEvent->time_100ms = gRxVfo->TAIL_TIME;
+	pEvent->mute_10ms  = ((rx.mute_tick == NO_TICK) ? tick_10ms : rx.mute_tick) - rx.trigger_tick;
+	pEvent->close_10ms = (rx.close_tick == NO_TICK) ? NO_TICK : (uint16_t)(rx.close_tick - rx.trigger_tick);
+
+	gTAIL_Stats.head = (gTAIL_Stats.head + 1) % TAIL_STATS_LEN;
+	if (gTAIL_Stats.count < TAIL_STATS_LEN)
+		gTAIL_Stats.count++;
+#endif
+
+	TAIL_RxReset();
+}
+
+void TAIL_RxReset(void)
+{
+#ifdef ENABLE_TAIL_STATS
+	rx.trigger    = TAIL_TRIGGER_NONE;
+	rx.mute_tick  = NO_TICK;
+	rx.close_tick = NO_TICK;
+#endif
+}
+
+void TAIL_StartRepeaterHold(void)
+{
+	gRTTECountdown_10ms = gEeprom.REPEATER_TAIL_TONE_ELIMINATION * 10;
+
+	if (gRTTECountdown_10ms == 0) {
+		if (!AUDIO_SeqBusy()) {
+			FUNCTION_Select(FUNCTION_FOREGROUND);
+			return;
+		}
+
+		gRTTECountdown_10ms = 1; // once the end of transmission tones are out
+	}
+}
+
+#ifdef ENABLE_TAIL_STATS
+static void Trigger(const uint8_t trigger)
+{
+	if (rx.trigger != TAIL_TRIGGER_NONE)
+		return;
+
+	rx.trigger      = trigger;
+	rx.trigger_tick = tick_10ms;
+}
+#endif
+
+void TAIL_HandleInterrupt(uint16_t status)
+{
+#ifdef ENABLE_TAIL_STATS
+	if (!FUNCTION_IsRx())
+		return;
+
+	// the BK4819 names are the other way round to g_SquelchLost,
+	// SQUELCH_LOST is the squelch opening and SQUELCH_FOUND it shutting
+
+	if ((status & BK4819_REG_02_SQUELCH_LOST) && rx.mute_tick == NO_TICK)
+		TAIL_RxReset();   // carrier's back, whatever we saw was a false alarm
+
+	if (status & BK4819_REG_02_CxCSS_TAIL)
+		Trigger(TAIL_TRIGGER_TAIL);
+
+	if (status & (BK4819_REG_02_CTCSS_LOST | BK4819_REG_02_CDCSS_LOST))
+		Trigger(TAIL_TRIGGER_CSS_LOST);
+
+	if (status & BK4819_REG_02_SQUELCH_FOUND) {
+		Trigger(TAIL_TRIGGER_SQUELCH);
+		if (rx.close_tick == NO_TICK)
+			rx.close_tick = tick_10ms;
+	}
+#else
+	(void)status;
+#endif
+}
+
+void TAIL_TimeSlice10ms(void)
+{
+#ifdef ENABLE_TAIL_STATS
+	tick_10ms++;
+#endif
+
+	// repeater tail tone elimination, counted from the end of the roger/PTT-ID tones
+	if (gCurrentFunction == FUNCTION_TRANSMIT && gRTTECountdown_10ms > 0 && !AUDIO_SeqBusy()) {
+		if (--gRTTECountdown_10ms == 0) {
+			FUNCTION_Select(FUNCTION_FOREGROUND);
+
+			gUpdateStatus  = true;
+			gUpdateDisplay = true;
+		}
+	}
+}
@@ -0,0 +1,100 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef TAIL_H
+#define TAIL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// squelch tail elimination, both ends of the link
+//
+// TX: once PTT is released the carrier stays up for the channel's tail time
+// with the sub-audio changed (55Hz tone or a CTCSS phase shift, 134.4Hz on
+// DCS channels) so the other radios can mute before the carrier drops.
+// RX: the BK4819 is told which tail to look for, HandleReceive() mutes for
+// the channel's tail time once it shows up.
+// RTTE: after our own TX the radio stays keyed for REPEATER_TAIL_TONE_ELIMINATION
+// so a repeater's tail is muted on its side.
+
+enum TAIL_Mode_t {
+	TAIL_MODE_DEFAULT = 0,   // 55Hz, 180° with ENABLE_CTCSS_TAIL_PHASE_SHIFT
+	TAIL_MODE_55HZ,
+	TAIL_MODE_120,           // phase shifts only apply to CTCSS channels,
+	TAIL_MODE_180,           // others fall back to 55Hz
+	TAIL_MODE_240,
+	TAIL_MODE_LAST = TAIL_MODE_240
+};
+
+typedef enum TAIL_Mode_t TAIL_Mode_t;
+
+#define TAIL_TIME_DEFAULT   2    // *100ms, what the stock firmware used
+#define TAIL_TIME_MAX       7    // 3 bits in the channel record
+
+// TX, queued on the audio sequencer at the end of a transmission
+void TAIL_QueueTx(void);
+// TX, blocking, for the paths that drop the carrier straight after
+void TAIL_SendTx(void);
+
+// RX, from RADIO_SetupRegisters(), tell the BK4819 which tail to look for
+void TAIL_SetupRx(uint8_t CodeType, uint8_t Code);
+// RX, the tail was spotted: mute now for the channel's tail time
+void TAIL_RxMute(void);
+// RX, reception is over (squelch closed, tone lost or the mute ran out)
+void TAIL_RxEnd(void);
+void TAIL_RxReset(void);
+
+// RTTE, going back to RX after APP_EndTransmission()
+void TAIL_StartRepeaterHold(void);
+
+// BK4819 REG_02 interrupt status, from CheckRadioInterrupts()
+void TAIL_HandleInterrupt(uint16_t status);
+void TAIL_TimeSlice10ms(void);
+
+#ifdef ENABLE_TAIL_STATS
+	#define TAIL_STATS_LEN  16
+
+	enum TAIL_Trigger_t {
+		TAIL_TRIGGER_NONE = 0,
+		TAIL_TRIGGER_TAIL,       // tail tone/phase shift detected
+		TAIL_TRIGGER_CSS_LOST,   // CTCSS/DCS went away
+		TAIL_TRIGGER_SQUELCH     // squelch closed
+	};
+
+	enum TAIL_End_t {
+		TAIL_END_TTE = 0,        // muted on the tail
+		TAIL_END_PLAIN           // muted when RX ended, the tail wasn't used
+	};
+
+	typedef struct {
+		uint8_t  trigger;        // TAIL_TRIGGER_*, whatever came first
+		uint8_t  end;            // TAIL_END_*
+		uint8_t  mode;           // TAIL_Mode_t the channel was using
+		uint8_t  time_100ms;     // tail time the channel was using
+		uint16_t mute_10ms;      // trigger to audio muted
+		uint16_t close_10ms;     // trigger to squelch closed, 0xFFFF if not before the end
+	} TAIL_Event_t;
+
+	typedef struct {
+		uint8_t      head;       // next slot to write
+		uint8_t      count;
+		TAIL_Event_t event[TAIL_STATS_LEN];
+	} TAIL_Stats_t;
+
+	extern TAIL_Stats_t gTAIL_Stats;
+#endif
+
+#endif
@@ -62,7 +62,7 @@ void UI_DisplayAircopy(void)
 	if (gAirCopyIsSendMode == 0) {
 		sprintf(String, "RCV:%u E:%u", gAirCopyBlockNumber, gErrorsDuringAirCopy);
 	} else if (gAirCopyIsSendMode == 1) {
-		sprintf(String, "SND:%u", gAirCopyBlockNumber);
+		sprintf(String, "SND:%u R:%u", gAirCopyBlockNumber, gAirCopyResends);
 	}
 	UI_PrintString(String, 2, 127, 4, 8);
 
@@ -23,6 +23,7 @@
 #include "audio.h"
 #include "driver/keyboard.h"
 #include "driver/st7565.h"
+#include "key_queue.h"
 #include "misc.h"
 #include "settings.h"
 #include "ui/helper.h"
@@ -49,7 +50,7 @@ static void Render(void)
 
 void UI_DisplayLock(void)
 {
-	KEY_Code_t  Key;
+	KEY_Event_t Event;
 	BEEP_Type_t Beep;
 
 	gUpdateDisplay = true;
@@ -60,87 +61,74 @@ void UI_DisplayLock(void)
 	{
 		while (!gNextTimeslice) {}
 
-		// TODO: Original code doesn't do the below, but is needed for proper key debounce
-
 		gNextTimeslice = false;
 
-		Key = KEYBOARD_Poll();
+		AUDIO_SeqTimeSlice10ms();
+
+		KEYQ_Scan(KEYBOARD_Poll(), gGlobalSysTickCounter);
 
-		if (gKeyReading0 == Key)
+		while (KEYQ_Get(&Event))
 		{
-			if (++gDebounceCounter == key_debounce_10ms)
+			if (Event.type != KEY_EVENT_PRESS)
+				continue;
+
+			switch (Event.key)
 			{
-				if (Key == KEY_INVALID)
-				{
-					gKeyReading1 = KEY_INVALID;
-				}
-				else
-				{
-					gKeyReading1 = Key;
-
-					switch (Key)
+				case KEY_0:
+				case KEY_1:
+				case KEY_2:
+				case KEY_3:
+				case KEY_4:
+				case KEY_5:
+				case KEY_6:
+				case KEY_7:
+				case KEY_8:
+				case KEY_9:
+					INPUTBOX_Append(Event.key - KEY_0);
+
+					if (gInputBoxIndex < 6)   // 6 frequency digits
+					{
+						Beep = BEEP_1KHZ_60MS_OPTIONAL;
+					}
+					else
 					{
-						case KEY_0:
-						case KEY_1:
-						case KEY_2:
-						case KEY_3:
-						case KEY_4:
-						case KEY_5:
-						case KEY_6:
-						case KEY_7:
-						case KEY_8:
-						case KEY_9:
-							INPUTBOX_Append(Key - KEY_0);
-
-							if (gInputBoxIndex < 6)   // 6 frequency digits
-							{
-								Beep = BEEP_1KHZ_60MS_OPTIONAL;
-							}
-							else
-							{
-								uint32_t Password;
-
-								gInputBoxIndex = 0;
-								Password = StrToUL(INPUTBOX_GetAscii());
-
-								if ((gEeprom.POWER_ON_PASSWORD) == Password)
-								{
-									AUDIO_PlayBeep(BEEP_1KHZ_60MS_OPTIONAL);
-									return;
-								}
-
-								memset(gInputBox, 10, sizeof(gInputBox));
-
-								Beep = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
-							}
-
-							AUDIO_PlayBeep(Beep);
-
-							gUpdateDisplay = true;
-							break;
-
-						case KEY_EXIT:
-							if (gInputBoxIndex > 0)
-							{
-								gInputBox[--gInputBoxIndex] = 10;
-								gUpdateDisplay = true;
-							}
+						uint32_t Password;
+
+						gInputBoxIndex = 0;
+						Password = StrToUL(INPUTBOX_GetAscii());
 
+						if ((gEeprom.POWER_ON_PASSWORD) == Password)
+						{
 							AUDIO_PlayBeep(BEEP_1KHZ_60MS_OPTIONAL);
 
-						default:
-							break;
+							// the main loop starts clean, the digit's release still comes
+							KEYQ_Reset(KEYQ_KeyDown());
+							return;
+						}
+
+						memset(gInputBox, 10, sizeof(gInputBox));
+
+						Beep = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
 					}
-				}
 
-				gKeyBeingHeld = false;
+					AUDIO_PlayBeep(Beep);
+
+					gUpdateDisplay = true;
+					break;
+
+				case KEY_EXIT:
+					if (gInputBoxIndex > 0)
+					{
+						gInputBox[--gInputBoxIndex] = 10;
+						gUpdateDisplay = true;
+					}
+
+					AUDIO_PlayBeep(BEEP_1KHZ_60MS_OPTIONAL);
+
+				default:
+					break;
 			}
 		}
-		else
-		{
-			gDebounceCounter = 0;
-			gKeyReading0     = Key;
-		}
 
 #ifdef ENABLE_UART
 		if (UART_IsCommandAvailable())
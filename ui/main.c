@@ -19,6 +19,9 @@
 
 #include "app/chFrScanner.h"
 #include "app/dtmf.h"
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	#include "app/main.h"
+#endif
 #ifdef ENABLE_AM_FIX
 	#include "am_fix.h"
 #endif
@@ -39,16 +42,6 @@
 
 center_line_t center_line = CENTER_LINE_NONE;
 
-const int8_t dBmCorrTable[7] = {
-			-15, // band 1
-			-25, // band 2
-			-20, // band 3
-			-4, // band 4
-			-7, // band 5
-			-6, // band 6
-			 -1  // band 7
-		};
-
 const char *VfoStateStr[] = {
        [VFO_STATE_NORMAL]="",
        [VFO_STATE_BUSY]="BUSY",
@@ -197,18 +190,20 @@ void DisplayRSSIBar(const bool now)
 
 
 	const int16_t s0_dBm   = -gEeprom.S0_LEVEL;                  // S0 .. base level
-	const int16_t rssi_dBm =
-		BK4819_GetRSSI_dBm()
-#ifdef ENABLE_AM_FIX
-		+ ((gSetting_AM_fix && gRxVfo->Modulation == MODULATION_AM) ? AM_fix_get_gain_diff() : 0)
-#endif
-		+ dBmCorrTable[gRxVfo->Band];
+	const int16_t rssi_dBm = (RADIO_GetCompensatedRssi() / 2) - 160;
 
 	int s0_9 = gEeprom.S0_LEVEL - gEeprom.S9_LEVEL;
 	const uint8_t s_level = MIN(MAX((int32_t)(rssi_dBm - s0_dBm)*100 / (s0_9*100/9), 0), 9); // S0 - S9
 	uint8_t overS9dBm = MIN(MAX(rssi_dBm + gEeprom.S9_LEVEL, 0), 99);
 	uint8_t overS9Bars = MIN(overS9dBm/10, 4);
 
+#ifdef ENABLE_AM_FIX
+	if(AM_fix_active(gRxVfo->Modulation) && AM_fix_overloaded(gEeprom.RX_VFO)) {
+		// front end overload, the gain is already as low as it goes
+		sprintf(str, "% 4d OVL", rssi_dBm);
+	}
+	else
+#endif
 	if(overS9Bars == 0) {
 		sprintf(str, "% 4d S%d", rssi_dBm, s_level);
 	}
@@ -222,7 +217,8 @@ void DisplayRSSIBar(const bool now)
 	if (now)
 		ST7565_BlitLine(line);
 #else
-	int16_t rssi = BK4819_GetRSSI();
+	// the calibration levels are raw BK4819 values
+	int16_t rssi = RADIO_GetRawRssi();
 	uint8_t Level;
 
 	if (rssi >= gEEPROM_RSSI_CALIB[gRxVfo->Band][3]) {
@@ -701,6 +697,19 @@ void UI_DisplayMain(void)
 
 		const bool rx = FUNCTION_IsRx();
 
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+		if (gNameSearchMode && gScreenToDisplay == DISPLAY_MAIN) {
+			center_line = CENTER_LINE_NAME_SEARCH;
+			strcpy(String, "NAME ");
+			for (unsigned int i = 0; i < gNameSearchCount; i++)
+				String[5 + i] = '0' + gNameSearchKeys[i];
+			String[5 + gNameSearchCount] = '_';
+			String[6 + gNameSearchCount] = 0;
+			UI_PrintStringSmallNormal(String, 2, 0, 3);
+		}
+		else
+#endif
+
 #ifdef ENABLE_AUDIO_BAR
 		if (gSetting_mic_bar && gCurrentFunction == FUNCTION_TRANSMIT) {
 			center_line = CENTER_LINE_AUDIO_BAR;
@@ -710,7 +719,7 @@ void UI_DisplayMain(void)
 #endif
 
 #if defined(ENABLE_AM_FIX) && defined(ENABLE_AM_FIX_SHOW_DATA)
-		if (rx && gEeprom.VfoInfo[gEeprom.RX_VFO].Modulation == MODULATION_AM && gSetting_AM_fix)
+		if (rx && AM_fix_active(gEeprom.VfoInfo[gEeprom.RX_VFO].Modulation))
 		{
 			if (gScreenToDisplay != DISPLAY_MAIN
 #ifdef ENABLE_DTMF_CALLING
@@ -784,7 +793,7 @@ void UI_DisplayMain(void)
 
 				sprintf(String, "Charge %u.%02uV %u%%",
 					gBatteryVoltageAverage / 100, gBatteryVoltageAverage % 100,
-					BATTERY_VoltsToPercent(gBatteryVoltageAverage));
+					BATTERY_GetPercent());
 				UI_PrintStringSmallNormal(String, 2, 0, 3);
 			}
 #endif
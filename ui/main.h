@@ -24,7 +24,8 @@ enum center_line_t {
 	CENTER_LINE_RSSI,
 	CENTER_LINE_AM_FIX_DATA,
 	CENTER_LINE_DTMF_DEC,
-	CENTER_LINE_CHARGE_DATA
+	CENTER_LINE_CHARGE_DATA,
+	CENTER_LINE_NAME_SEARCH
 };
 
 enum Vfo_txtr_mode{
@@ -36,7 +37,6 @@ enum Vfo_txtr_mode{
 typedef enum center_line_t center_line_t;
 
 extern center_line_t center_line;
-extern const int8_t dBmCorrTable[7];
 
 void UI_DisplayAudioBar(void);
 void UI_MAIN_TimeSlice500ms(void);
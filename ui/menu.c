@@ -21,6 +21,9 @@
 #include "../app/menu.h"
 #include "../bitmaps.h"
 #include "../board.h"
+#ifdef ENABLE_CHANNEL_BANKS
+	#include "../channel_bank.h"
+#endif
 #include "../dcs.h"
 #include "../driver/backlight.h"
 #include "../driver/bk4819.h"
@@ -29,6 +32,7 @@
 #include "../external/printf/printf.h"
 #include "../frequencies.h"
 #include "../helper/battery.h"
+#include "../helper/battery_model.h"
 #include "../misc.h"
 #include "../settings.h"
 #include "helper.h"
@@ -58,6 +62,9 @@ const t_menu_item MenuList[] =
 	{"ChSave", VOICE_ID_MEMORY_CHANNEL,                MENU_MEM_CH        }, // was "MEM-CH"
 	{"ChDele", VOICE_ID_DELETE_CHANNEL,                MENU_DEL_CH        }, // was "DEL-CH"
 	{"ChName", VOICE_ID_INVALID,                       MENU_MEM_NAME      },
+#ifdef ENABLE_CHANNEL_BANKS
+	{"ChBank", VOICE_ID_INVALID,                       MENU_CH_BANK       }, // memory channel set
+#endif
 
 	{"SList",  VOICE_ID_INVALID,                       MENU_S_LIST        },
 	{"SList1", VOICE_ID_INVALID,                       MENU_SLIST1        },
@@ -87,12 +94,16 @@ const t_menu_item MenuList[] =
 	{"BLMax",  VOICE_ID_INVALID,                       MENU_ABR_MAX       },
 	{"BltTRX", VOICE_ID_INVALID,                       MENU_ABR_ON_TX_RX  },
 	{"Beep",   VOICE_ID_BEEP_PROMPT,                   MENU_BEEP          },
+	{"KeyLng", VOICE_ID_INVALID,                       MENU_KEY_LONG      }, // long press time
+	{"KeyRpt", VOICE_ID_INVALID,                       MENU_KEY_RPT       }, // UP/DOWN repeat rate
 #ifdef ENABLE_VOICE
 	{"Voice",  VOICE_ID_VOICE_PROMPT,                  MENU_VOICE         },
 #endif
 	{"Roger",  VOICE_ID_INVALID,                       MENU_ROGER         },
 	{"STE",    VOICE_ID_INVALID,                       MENU_STE           },
 	{"RP STE", VOICE_ID_INVALID,                       MENU_RP_STE        },
+	{"STE Md", VOICE_ID_INVALID,                       MENU_STE_MODE      },
+	{"STE T",  VOICE_ID_INVALID,                       MENU_STE_TIME      },
 	{"1 Call", VOICE_ID_INVALID,                       MENU_1_CALL        },
 #ifdef ENABLE_ALARM
 	{"AlarmT", VOICE_ID_INVALID,                       MENU_AL_MOD        },
@@ -253,6 +264,15 @@ const char* const gSubMenu_PTT_ID[] =
 	"APOLLO\nQUINDAR"
 };
 
+const char gSubMenu_STE_MODE[][8] =
+{
+	"DEFAULT",
+	"55Hz",
+	"120deg",
+	"180deg",
+	"240deg"
+};
+
 const char gSubMenu_PONMSG[][8] =
 {
 	"FULL",
@@ -363,7 +383,13 @@ const t_sidefunction gSubMenu_SIDEFUNCTIONS[] =
 	{"BLMIN\nTMP OFF",  ACTION_OPT_BLMIN_TMP_OFF}, 		//BackLight Minimum Temporay OFF
 #endif
 #ifdef ENABLE_SPECTRUM
-	{"SPECTRUM",         ACTION_OPT_SPECTRUM}
+	{"SPECTRUM",         ACTION_OPT_SPECTRUM},
+#endif
+#ifdef ENABLE_BACKLIGHT_FADE
+	{"BL NIGHT",         ACTION_OPT_BL_NIGHT},
+#endif
+#ifdef ENABLE_CHANNEL_NAME_SEARCH
+	{"NAME\nSEARCH",     ACTION_OPT_NAME_SEARCH},
 #endif
 };
 
@@ -726,6 +752,14 @@ void UI_DisplayMenu(void)
 				sprintf(String, "%d*100ms", gSubMenuSelection);
 			break;
 
+		case MENU_STE_MODE:
+			strcpy(String, gSubMenu_STE_MODE[gSubMenuSelection]);
+			break;
+
+		case MENU_STE_TIME:
+			sprintf(String, "%d*100ms", gSubMenuSelection);
+			break;
+
 		case MENU_S_LIST:
 			if (gSubMenuSelection < 2)
 				sprintf(String, "LIST%u", 1 + gSubMenuSelection);
@@ -765,6 +799,20 @@ void UI_DisplayMenu(void)
 			sprintf(String, "%d*10ms", gSubMenuSelection);
 			break;
 
+		case MENU_KEY_LONG:
+			sprintf(String, "%dms", gSubMenuSelection * 100);
+			break;
+
+#ifdef ENABLE_CHANNEL_BANKS
+		case MENU_CH_BANK:
+			sprintf(String, "BANK\n%d/%d", gSubMenuSelection + 1, CHBANK_COUNT);
+			break;
+#endif
+
+		case MENU_KEY_RPT:
+			sprintf(String, "%dms", gSubMenuSelection * 10);
+			break;
+
 		case MENU_PTT_ID:
 			strcpy(String, gSubMenu_PTT_ID[gSubMenuSelection]);
 			break;
@@ -794,7 +842,16 @@ void UI_DisplayMenu(void)
 		case MENU_VOL:
 			sprintf(String, "%u.%02uV\n%u%%",
 				gBatteryVoltageAverage / 100, gBatteryVoltageAverage % 100,
-				BATTERY_VoltsToPercent(gBatteryVoltageAverage));
+				BATTERY_GetPercent());
+#ifdef ENABLE_BATTERY_MODEL
+			{	// time left at the recent average draw
+				const uint16_t minutes = BATMODEL_GetMinutesLeft();
+				if (minutes == 0xFFFF)
+					strcat(String, "\n--:--");
+				else
+					sprintf(String + strlen(String), "\n%uh%02um", minutes / 60, minutes % 60);
+			}
+#endif
 			break;
 
 		case MENU_RESET:
@@ -47,6 +47,9 @@ enum
 	MENU_MEM_CH,
 	MENU_DEL_CH,
 	MENU_MEM_NAME,
+#ifdef ENABLE_CHANNEL_BANKS
+	MENU_CH_BANK,
+#endif
 	MENU_MDF,
 	MENU_SAVE,
 #ifdef ENABLE_VOX
@@ -58,6 +61,8 @@ enum
 	MENU_ABR_MAX,
 	MENU_TDR,
 	MENU_BEEP,
+	MENU_KEY_LONG,
+	MENU_KEY_RPT,
 #ifdef ENABLE_VOICE
 	MENU_VOICE,
 #endif
@@ -67,6 +72,8 @@ enum
 	MENU_S_ADD2,
 	MENU_STE,
 	MENU_RP_STE,
+	MENU_STE_MODE,
+	MENU_STE_TIME,
 	MENU_MIC,
 #ifdef ENABLE_AUDIO_BAR
 	MENU_MIC_BAR,
@@ -149,6 +156,7 @@ extern const char* const gSubMenu_MDF[4];
 extern const char        gSubMenu_D_RSP[4][11];
 #endif
 extern const char* const gSubMenu_PTT_ID[5];
+extern const char        gSubMenu_STE_MODE[5][8];
 extern const char        gSubMenu_PONMSG[4][8];
 extern const char        gSubMenu_ROGER[3][6];
 extern const char        gSubMenu_RESET[2][4];
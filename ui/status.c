@@ -162,7 +162,7 @@ void UI_DisplayStatus()
 			}
 
 			case 2:		// percentage
-				sprintf(s, "%u%%", BATTERY_VoltsToPercent(gBatteryVoltageAverage));
+				sprintf(s, "%u%%", BATTERY_GetPercent());
 				break;
 		}
 
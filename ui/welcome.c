@@ -59,7 +59,7 @@ void UI_DisplayWelcome(void)
 			sprintf(WelcomeString1, "%u.%02uV %u%%",
 				gBatteryVoltageAverage / 100,
 				gBatteryVoltageAverage % 100,
-				BATTERY_VoltsToPercent(gBatteryVoltageAverage));
+				BATTERY_GetPercent());
 		}
 		else
 		{
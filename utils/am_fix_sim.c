@@ -0,0 +1,356 @@
+/* Copyright 2023 OneOfEleven
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// offline AM fix simulator
+//
+// runs the real AM_fix_10ms() from am_fix.c (#included below) on the PC against a recorded or
+// synthetic RSSI trace, with the BK4819 register access (and the per tick
+// RSSI cache in radio.c) mocked out, so the AGC can be tuned without sitting
+// at the radio
+//
+// build and run (from the repo root):
+//
+//   make am_fix_sim
+//   ./am_fix_sim -s fade
+//   ./am_fix_sim -v capture.csv > trajectory.csv
+//
+// the tuning values in am_fix.c can be overridden when building, eg.
+//
+//   make am_fix_sim AM_FIX_SIM_FLAGS="-DAM_FIX_HOLD_10ms=50 -DAM_FIX_DESIRED_RSSI_dBm=-85"
+//
+// a trace file has one line per 10ms tick, the last number on the line is
+// the BK4819 REG_67 RSSI value (0.5dB units, dBm = (value / 2) - 160) as read
+// with REG_13 at the original QS setting (0x03BE) unless -g says otherwise,
+// so "12340,0x8C" and "140" are both fine, anything else is skipped
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// built in rather than linked, the simulator reads the AGC's own state
+#include "am_fix.c"
+#undef printf          // am_fix.c brings in external/printf, this runs on the host
+#include "driver/bk4819.h"
+#include "frequencies.h"
+#include "functions.h"
+#include "misc.h"
+#include "settings.h"
+
+// *************************************************************
+// the firmware bits am_fix.c needs
+
+EEPROM_Config_t  gEeprom;
+FUNCTION_Type_t  gCurrentFunction = FUNCTION_RECEIVE;
+bool             gSetting_AM_fix  = true;
+bool             gUpdateDisplay;
+
+static FREQ_Config_t    sim_freq = {.Frequency = 11830000};
+static FREQUENCY_Band_t sim_band = BAND2_108MHz;
+static ModulationMode_t sim_modulation = MODULATION_AM;
+
+bool FUNCTION_IsRx()
+{
+	return true;
+}
+
+FREQUENCY_Band_t FREQUENCY_GetBand(uint32_t Frequency)
+{
+	(void)Frequency;
+	return sim_band;
+}
+
+// *************************************************************
+// mocked BK4819
+
+#define MAX_LATENCY 8
+
+static uint16_t reg13_ref = 0x03BE;         // REG_13 in use when the trace was recorded
+static uint16_t reg13_pipe[MAX_LATENCY + 1];  // REG_13 history, [0] = the one the RSSI reflects
+static unsigned latency = 1;                // ticks before a REG_13 write shows in the RSSI
+static int16_t  trace_rssi;                 // current trace value
+static uint16_t rssi_seen;                  // what the firmware got back
+static unsigned write_count;
+
+static int reg13_gain_dB(const uint16_t reg)
+{
+	static const int8_t lna_short_dB[] = {-28, -24, -19,   0};
+	static const int8_t lna_dB[]       = {-24, -19, -14,  -9, -6, -4, -2, 0};
+	static const int8_t mixer_dB[]     = { -8,  -6,  -3,   0};
+	static const int8_t pga_dB[]       = {-33, -27, -21, -15, -9, -6, -3, 0};
+
+	return lna_short_dB[(reg >> 8) & 3] + lna_dB[(reg >> 5) & 7] + mixer_dB[(reg >> 3) & 3] + pga_dB[reg & 7];
+}
+
+uint16_t BK4819_GetRSSI(void)
+{
+	int rssi = trace_rssi + (reg13_gain_dB(reg13_pipe[0]) - reg13_gain_dB(reg13_ref)) * 2;
+	rssi_seen = (rssi < 0) ? 0 : (rssi > 0x1FF) ? 0x1FF : rssi;
+	return rssi_seen;
+}
+
+void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
+{
+	if (Register != BK4819_REG_13)
+		return;
+	for (unsigned i = latency; i <= MAX_LATENCY; i++)
+		reg13_pipe[i] = Data;
+	write_count++;
+}
+
+uint16_t RADIO_GetRawRssi(void)
+{
+	return BK4819_GetRSSI();
+}
+
+static void clock_registers(void)
+{
+	memmove(&reg13_pipe[0], &reg13_pipe[1], MAX_LATENCY * sizeof(reg13_pipe[0]));
+}
+
+// *************************************************************
+// traces
+
+static int16_t *trace;
+static unsigned trace_len;
+
+static void trace_add(const int value)
+{
+	static unsigned size;
+	if (trace_len >= size) {
+		size  = size ? size * 2 : 1024;
+		trace = realloc(trace, size * sizeof(*trace));
+		if (trace == NULL) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+	}
+	trace[trace_len++] = value;
+}
+
+static int dBm_to_rssi(const double dBm)
+{
+	return (int)lround((dBm + 160) * 2);
+}
+
+static bool load_trace(const char *filename)
+{
+	FILE *file = fopen(filename, "r");
+	if (file == NULL) {
+		perror(filename);
+		return false;
+	}
+
+	char line[256];
+	while (fgets(line, sizeof(line), file) != NULL) {
+		char *s = strrchr(line, ',');
+		s = (s == NULL) ? line : s + 1;
+		char *end;
+		const long value = strtol(s, &end, 0);
+		if (end == s)
+			continue;    // header/comment
+		trace_add(value & 0x1FF);
+	}
+
+	fclose(file);
+	return trace_len > 0;
+}
+
+static double noise(void)
+{	// repeatable +/-1dB noise
+	static uint32_t seed = 12345;
+	seed = seed * 1103515245u + 12345u;
+	return ((int)((seed >> 16) & 0xFF) - 128) / 128.0;
+}
+
+static bool synth_trace(const char *name)
+{
+	if (strcmp(name, "step") == 0) {
+		// noise floor, strong carrier, noise floor again
+		for (unsigned i = 0; i < 500; i++) {
+			const double dBm = (i >= 100 && i < 300) ? -50 : -115;
+			trace_add(dBm_to_rssi(dBm + noise()));
+		}
+	}
+	else if (strcmp(name, "fade") == 0) {
+		// strong carrier with 20dB deep 2Hz flutter (aircraft)
+		for (unsigned i = 0; i < 1000; i++) {
+			const double dBm = -60 - 10 - 10 * sin(2 * M_PI * 2.0 * i / 100.0);
+			trace_add(dBm_to_rssi(dBm + noise()));
+		}
+	}
+	else if (strcmp(name, "burst") == 0) {
+		// short overs of different strength with gaps between them
+		static const int8_t level_dBm[] = {-45, -75, -60, -90, -50};
+		for (unsigned k = 0; k < ARRAY_SIZE(level_dBm); k++) {
+			for (unsigned i = 0; i < 150; i++)
+				trace_add(dBm_to_rssi(level_dBm[k] + noise()));
+			for (unsigned i = 0; i < 50; i++)
+				trace_add(dBm_to_rssi(-115 + noise()));
+		}
+	}
+	else {
+		fprintf(stderr, "unknown synthetic trace '%s'\n", name);
+		return false;
+	}
+
+	return true;
+}
+
+// *************************************************************
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s [options] <trace.csv>\n"
+		"       %s [options] -s step|fade|burst\n"
+		"\n"
+		"  -s name  use a synthetic trace\n"
+		"  -g reg   REG_13 value the trace was recorded with (default 0x03BE)\n"
+		"  -l n     ticks before a REG_13 write shows in the RSSI (default 1)\n"
+		"  -b n     band index used for the wanted RSSI (default 1, airband)\n"
+		"  -m n     modulation index (default 1, AM), others need ENABLE_SOFT_AGC\n"
+		"  -v       print the per tick trajectory as CSV\n",
+		name, name);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *synth   = NULL;
+	const char *file    = NULL;
+	bool        verbose = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-v") == 0)
+			verbose = true;
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			synth = argv[++i];
+		else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+			reg13_ref = strtol(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+			latency = strtol(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+			sim_band = strtol(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+			sim_modulation = strtol(argv[++i], NULL, 0);
+		else if (argv[i][0] != '-' && file == NULL)
+			file = argv[i];
+		else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (latency > MAX_LATENCY || sim_band < 0 || sim_band >= BAND_N_ELEM || (synth == NULL) == (file == NULL)) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (!AM_fix_active(sim_modulation)) {
+		fprintf(stderr, "AM fix doesn't handle modulation %d in this build\n", sim_modulation);
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (synth != NULL ? !synth_trace(synth) : !load_trace(file))
+		return 1;
+
+	gEeprom.VfoInfo[0].pRX = &sim_freq;
+	for (unsigned i = 0; i <= MAX_LATENCY; i++)
+		reg13_pipe[i] = 0x03BE;    // BK4819_InitAGC()
+
+	AM_fix_init();
+	AM_fix_reset(0);
+
+	// the first AM_fix_10ms() call sets up the wanted RSSI for the band
+	const int settle_window = 50;           // ticks the index must stay put to count as settled (longer than the gain hold)
+	const int settle_step   = 6 * 2;        // input change (0.5dB units) that starts a settling measurement
+
+	unsigned index_changes  = 0;
+	unsigned reversals      = 0;
+	int      last_dir       = 0;
+	unsigned last_index     = gain_table_index[0];
+	unsigned last_change    = 0;
+	int      step_start     = 0;            // tick of the last input step
+	bool     settling       = true;
+	unsigned settle_count   = 0;
+	unsigned settle_total   = 0;
+	unsigned settle_max     = 0;
+	int      overshoot      = 0;            // worst RSSI above wanted (0.5dB units)
+	unsigned ticks_over     = 0;            // ticks more than 3dB above wanted
+
+	if (verbose)
+		printf("t_ms,trace_rssi,rssi_seen,index,reg13,gain_dB\n");
+
+	for (unsigned t = 0; t < trace_len; t++) {
+		if (t > 0 && abs(trace[t] - trace[t - 1]) >= settle_step) {
+			if (settling) {
+				settle_count++;    // never settled, count it as lasting until now
+				settle_total += t - step_start;
+				if (t - step_start > settle_max)
+					settle_max = t - step_start;
+			}
+			step_start = t;
+			settling   = true;
+		}
+
+		trace_rssi = trace[t];
+		AM_fix_10ms(0, sim_modulation);
+		clock_registers();
+
+		const unsigned index = gain_table_index[0];
+		if (index != last_index) {
+			const int dir = (index > last_index) ? 1 : -1;
+			if (last_dir != 0 && dir != last_dir)
+				reversals++;
+			last_dir    = dir;
+			last_index  = index;
+			last_change = t;
+			index_changes++;
+		}
+
+		if (settling && t - last_change >= (unsigned)settle_window && t - step_start >= (unsigned)settle_window) {
+			const unsigned ticks = (last_change > (unsigned)step_start) ? last_change - step_start : 0;
+			settle_count++;
+			settle_total += ticks;
+			if (ticks > settle_max)
+				settle_max = ticks;
+			settling = false;
+		}
+
+		const int over = (int)rssi_seen - desired_rssi[0];
+		if (over > overshoot)
+			overshoot = over;
+		if (over > 3 * 2)
+			ticks_over++;
+
+		if (verbose)
+			printf("%u,%d,%u,%u,0x%04X,%d\n", t * 10, trace[t], rssi_seen, index, reg13_pipe[0], reg13_gain_dB(reg13_pipe[0]));
+	}
+
+	fprintf(stderr, "ticks              %u (%u ms)\n", trace_len, trace_len * 10);
+	fprintf(stderr, "wanted RSSI        %d dBm\n", desired_rssi[0] / 2 - 160);
+	fprintf(stderr, "REG_13 writes      %u (%.1f%% of ticks)\n", write_count, 100.0 * write_count / trace_len);
+	fprintf(stderr, "gain index changes %u, %u direction reversals\n", index_changes, reversals);
+	fprintf(stderr, "settling time      avg %u ms, max %u ms over %u input steps\n",
+		settle_count ? settle_total * 10 / settle_count : 0, settle_max * 10, settle_count);
+	fprintf(stderr, "overshoot          %.1f dB above wanted, %u ms more than 3dB above\n", overshoot / 2.0, ticks_over * 10);
+
+	free(trace);
+	return 0;
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+
+# generates the sorted/de-duplicated front end gain table used by am_fix.c
+# when LOOKUP_TABLE is set to 0
+#
+# the table used to be built at boot-up by CreateTable() in a RAM array,
+# it's now built here on the host and stored as a const array in flash
+#
+# usage: python3 utils/am_fix_table.py > am_fix_table.h
+
+import sys
+
+# front end register dB values (REG_13)
+LNA_SHORT_DB = [-28, -24, -19,   0]   # corrected'ish
+LNA_DB       = [-24, -19, -14,  -9, -6, -4, -2, 0]
+MIXER_DB     = [ -8,  -6,  -3,   0]
+PGA_DB       = [-33, -27, -21, -15, -9, -6, -3, 0]
+
+# original QS setting, always kept at index 0
+ORIG_REG_VAL = 0x03BE
+ORIG_GAIN_DB = -7
+
+
+def reg_val(lna_short, lna, mixer, pga):
+    return (lna_short << 8) | (lna << 5) | (mixer << 3) | (pga << 0)
+
+
+def create_table():
+    table = {}   # gain_dB -> (reg_val, lna_short, lna, mixer, pga)
+
+    for lna_short in range(len(LNA_SHORT_DB)):
+        for lna in range(len(LNA_DB)):
+            for mixer in range(len(MIXER_DB)):
+                for pga in range(len(PGA_DB)):
+                    db = LNA_SHORT_DB[lna_short] + LNA_DB[lna] + MIXER_DB[mixer] + PGA_DB[pga]
+                    # first register combination found for a given dB value wins
+                    if db not in table:
+                        table[db] = (reg_val(lna_short, lna, mixer, pga), lna_short, lna, mixer, pga)
+
+    return [(db,) + table[db] for db in sorted(table)]
+
+
+def main():
+    table = create_table()
+    out = sys.stdout
+
+    out.write("// generated by utils/am_fix_table.py - do not edit\n")
+    out.write("//\n")
+    out.write("// index .. LNA-S LNA MIXER PGA .. gain\n")
+    out.write("\n")
+    out.write("#ifndef AM_FIX_TABLE_H\n")
+    out.write("#define AM_FIX_TABLE_H\n")
+    out.write("\n")
+    out.write("static const t_gain_table gain_table[] =\n")
+    out.write("{\n")
+    out.write("\t{0x%04X, %3d},  //  0 .. original\n" % (ORIG_REG_VAL, ORIG_GAIN_DB))
+    out.write("\n")
+    for i, (db, val, lna_short, lna, mixer, pga) in enumerate(table, 1):
+        sep = "," if i < len(table) else " "
+        out.write("\t{0x%04X, %3d}%s  // %2u .. %u %u %u %u .. %3ddB\n" % (val, db, sep, i, lna_short, lna, mixer, pga, db))
+    out.write("};\n")
+    out.write("\n")
+    out.write("#endif\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,272 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+
+// checks the generated am_fix_table.h against the table CreateTable() used
+// to build in RAM at boot-up
+//
+// build and run (from the repo root):
+//
+//   make am_fix_table_test
+//   ./am_fix_table_test        (-v lists both tables side by side)
+//
+// CreateTable() is copied here twice:
+//
+//   CreateTableOld()   exactly as it was in am_fix.c
+//   CreateTableFixed() the same search/insert, with its two bugs fixed
+//
+// the generated table has to match the fixed one entry for entry, the
+// differences from the old one are listed and have to be exactly the two
+// known bugs:
+//
+//   - an empty slot was recognised by gain_dB == 0, so the genuine 0dB
+//     combination (everything at max) matched the first empty slot and was
+//     never stored, the table then ended with that empty {0x0000, 0} slot
+//   - memmove() was given 100 - i bytes instead of entries, so every insert
+//     only shifted the first third of the tail, what was past that was
+//     left torn, a few entries ended up with a register value that sets a
+//     different gain than the entry says
+//   - the GainData union was only initialised through its 10 bits of
+//     bitfields, so bits 15:10 of the register value were whatever was on
+//     the stack, they're masked off here before comparing
+//
+// exits 1 if anything else differs
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "misc.h"
+
+typedef struct
+{
+	uint16_t reg_val;
+	int8_t   gain_dB;
+} __attribute__((packed)) t_gain_table;
+
+#include "am_fix_table.h"
+
+typedef union  {
+    struct {
+        uint8_t pgaIdx:3;
+        uint8_t mixerIdx:2;
+        uint8_t lnaIdx:3;
+        uint8_t lnaSIdx:2;
+    };
+    uint16_t __raw;
+} GainData;
+
+static const int8_t lna_short_dB[] = {-28, -24, -19,  0};   // corrected'ish
+static const int8_t lna_dB[]       = {-24, -19, -14,  -9, -6, -4, -2, 0};
+static const int8_t mixer_dB[]     = { -8,  -6,  -3,   0};
+static const int8_t pga_dB[]       = {-33, -27, -21, -15, -9, -6, -3, 0};
+
+static t_gain_table old_table[100];
+static uint8_t      old_size;
+static t_gain_table fixed_table[100];
+static uint8_t      fixed_size;
+
+// verbatim from am_fix.c before the table was generated on the host
+static void CreateTableOld(void)
+{
+	t_gain_table *gain_table = old_table;
+	unsigned i = 0;
+
+	memset(old_table, 0, sizeof(old_table));
+	old_table[0] = (t_gain_table){0x03BE, -7}; //original
+
+    for (uint8_t lnaSIdx = 0; lnaSIdx < ARRAY_SIZE(lna_short_dB); lnaSIdx++) {
+        for (uint8_t lnaIdx = 0; lnaIdx < ARRAY_SIZE(lna_dB); lnaIdx++) {
+            for (uint8_t mixerIdx = 0; mixerIdx < ARRAY_SIZE(mixer_dB); mixerIdx++) {
+                for (uint8_t pgaIdx = 0; pgaIdx < ARRAY_SIZE(pga_dB); pgaIdx++) {
+                    int16_t db = lna_short_dB[lnaSIdx] + lna_dB[lnaIdx] + mixer_dB[mixerIdx] + pga_dB[pgaIdx];
+                    GainData gainData = {{
+                        pgaIdx,
+                        mixerIdx,
+                        lnaIdx,
+                        lnaSIdx,
+                    }};
+
+                    for (i = 1; i < ARRAY_SIZE(old_table); i++) {
+                        t_gain_table * gain = &gain_table[i];
+                        if (db == gain->gain_dB)
+                            break;
+                        if (db > gain->gain_dB)
+                            continue;
+                        if (db < gain->gain_dB) {
+                            if(gain->gain_dB)
+                                memmove(gain + 1, gain, 100 - i);
+                            gain->gain_dB = db;
+                            gain->reg_val = gainData.__raw;
+                            break;
+                        }
+                        gain->gain_dB = db;
+                        gain->reg_val = gainData.__raw;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    old_size = i+1;
+
+	// the stack garbage above the bitfields
+	for (i = 0; i < old_size; i++)
+		old_table[i].reg_val &= 0x03FF;
+}
+
+// the same, with the used size tracked instead of testing for gain_dB == 0
+// and the tail moved a whole entry at a time
+static void CreateTableFixed(void)
+{
+	memset(fixed_table, 0, sizeof(fixed_table));
+	fixed_table[0] = (t_gain_table){0x03BE, -7};
+	fixed_size     = 1;
+
+	for (uint8_t lnaSIdx = 0; lnaSIdx < ARRAY_SIZE(lna_short_dB); lnaSIdx++) {
+		for (uint8_t lnaIdx = 0; lnaIdx < ARRAY_SIZE(lna_dB); lnaIdx++) {
+			for (uint8_t mixerIdx = 0; mixerIdx < ARRAY_SIZE(mixer_dB); mixerIdx++) {
+				for (uint8_t pgaIdx = 0; pgaIdx < ARRAY_SIZE(pga_dB); pgaIdx++) {
+					const int16_t db = lna_short_dB[lnaSIdx] + lna_dB[lnaIdx] + mixer_dB[mixerIdx] + pga_dB[pgaIdx];
+					GainData gainData;
+					unsigned i;
+
+					gainData.__raw = 0;
+					gainData.pgaIdx   = pgaIdx;
+					gainData.mixerIdx = mixerIdx;
+					gainData.lnaIdx   = lnaIdx;
+					gainData.lnaSIdx  = lnaSIdx;
+
+					for (i = 1; i < fixed_size && db > fixed_table[i].gain_dB; i++) {}
+
+					if (i < fixed_size && db == fixed_table[i].gain_dB)
+						continue;   // first combination found for a dB value wins
+
+					memmove(&fixed_table[i + 1], &fixed_table[i], (fixed_size - i) * sizeof(fixed_table[0]));
+					fixed_table[i].gain_dB = db;
+					fixed_table[i].reg_val = gainData.__raw;
+					fixed_size++;
+				}
+			}
+		}
+	}
+}
+
+// the gain a REG_13 value really sets
+static int Gain(const uint16_t reg_val)
+{
+	return lna_short_dB[(reg_val >> 8) & 3] + lna_dB[(reg_val >> 5) & 7] + mixer_dB[(reg_val >> 3) & 3] + pga_dB[reg_val & 7];
+}
+
+static bool Same(const t_gain_table *a, const t_gain_table *b)
+{
+	return a->reg_val == b->reg_val && a->gain_dB == b->gain_dB;
+}
+
+int main(int argc, char *argv[])
+{
+	const bool     verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+	const unsigned size    = ARRAY_SIZE(gain_table);
+	unsigned       errors  = 0;
+	unsigned       old_diffs = 0;
+	unsigned       old_wrong = 0;
+	bool           zero_dB = false;
+
+	CreateTableOld();
+	CreateTableFixed();
+
+	if (verbose) {
+		printf("index  generated     fixed         old\n");
+		for (unsigned i = 0; i < 100; i++) {
+			if (i >= size && i >= fixed_size && i >= old_size)
+				break;
+			printf("%5u", i);
+			if (i < size)       printf("  {0x%04X,%4d}", gain_table[i].reg_val, gain_table[i].gain_dB);  else printf("%15s", "");
+			if (i < fixed_size) printf("  {0x%04X,%4d}", fixed_table[i].reg_val, fixed_table[i].gain_dB); else printf("%15s", "");
+			if (i < old_size)   printf("  {0x%04X,%4d}", old_table[i].reg_val, old_table[i].gain_dB);
+			printf("\n");
+		}
+		printf("\n");
+	}
+
+	// the generated table against the fixed CreateTable()
+	if (size != fixed_size) {
+		printf("FAIL: am_fix_table.h has %u entries, CreateTable() builds %u\n", size, fixed_size);
+		errors++;
+	}
+	for (unsigned i = 0; i < size && i < fixed_size; i++) {
+		if (!Same(&gain_table[i], &fixed_table[i])) {
+			printf("FAIL: entry %2u is {0x%04X,%4d}, CreateTable() builds {0x%04X,%4d}\n", i,
+				gain_table[i].reg_val, gain_table[i].gain_dB, fixed_table[i].reg_val, fixed_table[i].gain_dB);
+			errors++;
+		}
+	}
+
+	// the generated table against the old CreateTable(), apart from the
+	// missing 0dB entry it has to hold the same dB values in the same order,
+	// only the register combination picked for a dB value may differ (the
+	// short memmove())
+	for (unsigned i = 0; i < old_size; i++) {
+		const t_gain_table *old = &old_table[i];
+
+		if (i + 1u == old_size && old->reg_val == 0x0000 && old->gain_dB == 0) {
+			zero_dB = true;   // the empty slot left where the 0dB entry should be
+			continue;
+		}
+
+		if (i >= size || old->gain_dB != gain_table[i].gain_dB) {
+			printf("FAIL: old entry %2u {0x%04X,%4d} isn't at the same place in am_fix_table.h\n", i, old->reg_val, old->gain_dB);
+			errors++;
+		}
+		else
+		if (!Same(old, &gain_table[i]))
+			old_diffs++;
+	}
+
+	if (!zero_dB || old_size != size) {
+		printf("FAIL: the old table was expected to end with an empty slot instead of the 0dB entry\n");
+		errors++;
+	}
+
+	// every entry has to set the gain it says it does
+	for (unsigned i = 1; i < size; i++) {
+		if (Gain(gain_table[i].reg_val) != gain_table[i].gain_dB) {
+			printf("FAIL: entry %2u {0x%04X,%4d} sets %ddB\n", i, gain_table[i].reg_val, gain_table[i].gain_dB, Gain(gain_table[i].reg_val));
+			errors++;
+		}
+	}
+	for (unsigned i = 1; i + 1u < old_size; i++)
+		if (Gain(old_table[i].reg_val) != old_table[i].gain_dB)
+			old_wrong++;
+
+	if (size == 0 || gain_table[size - 1].gain_dB != 0 || gain_table[size - 1].reg_val != 0x03FF) {
+		printf("FAIL: am_fix_table.h doesn't end with the 0dB entry\n");
+		errors++;
+	}
+
+	printf("am_fix_table.h %u entries, CreateTable() fixed %u, as it was %u (0dB entry missing, %u other register values differ, %u of them set the wrong gain)\n",
+		size, fixed_size, old_size, old_diffs, old_wrong);
+
+	if (errors > 0) {
+		printf("%u errors\n", errors);
+		return 1;
+	}
+
+	printf("ok\n");
+	return 0;
+}
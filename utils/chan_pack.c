@@ -0,0 +1,328 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// channel bank converter
+//
+// packs the 200 memory channels of an EEPROM dump (the 8KB a CPS or k5prog
+// reads from the radio) into a compact channel bank (channel_codec.h), and
+// unpacks a bank back over the channels of a dump, using the same
+// channel_codec.c as the firmware
+//
+// build and run (from the repo root):
+//
+//   make chan_pack
+//   ./chan_pack pack eeprom.bin bank.bin       channels to a bank image
+//   ./chan_pack unpack bank.bin eeprom.bin     a bank over the channels in eeprom.bin
+//   ./chan_pack test [eeprom.bin]              round trip every channel, print the sizes
+//
+// with ENABLE_CHANNEL_BANKS a bank image goes in at 0x2100 + bank * 0x1400
+// on the radio. test without a dump makes up a memory list of repeaters,
+// PMR/FRS, airband and marine channels; it exits with 1 if a channel
+// doesn't come back the same
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "channel_codec.h"
+
+#define EEPROM_SIZE          0x2000
+#define BANK_SIZE            0x1400     // CHBANK_SIZE
+
+static uint8_t eeprom[EEPROM_SIZE];
+static uint8_t bank[BANK_SIZE];
+
+static bool IsEmpty(const uint8_t Attributes)
+{
+	return (Attributes & 0x0F) > 6;   // past BAND7_470MHz
+}
+
+static void Fetch(unsigned int Channel, CHCODEC_Stock_t *pStock)
+{
+	memcpy(pStock->data, &eeprom[Channel * 16], sizeof(pStock->data));
+	memcpy(pStock->name, &eeprom[0x0F50 + (Channel * 16)], sizeof(pStock->name));
+	pStock->attributes = eeprom[0x0D60 + Channel];
+}
+
+static void Place(unsigned int Channel, const CHCODEC_Stock_t *pStock)
+{
+	memcpy(&eeprom[Channel * 16], pStock->data, sizeof(pStock->data));
+	memset(&eeprom[0x0F50 + (Channel * 16)], 0, 16);
+	memcpy(&eeprom[0x0F50 + (Channel * 16)], pStock->name, sizeof(pStock->name));
+	eeprom[0x0D60 + Channel] = pStock->attributes;
+}
+
+// the channels in eeprom[] to bank[], the size used or 0 if it doesn't fit
+static unsigned int Pack(void)
+{
+	unsigned int offset = CHBANK_RECORDS;
+
+	memset(bank, 0xFF, sizeof(bank));
+	bank[0] = CHBANK_MAGIC_0;
+	bank[1] = CHBANK_MAGIC_1;
+	bank[2] = CHBANK_VERSION;
+	bank[3] = CHBANK_CHANNELS;
+
+	for (unsigned int i = 0; i < CHBANK_CHANNELS; i++) {
+		CHCODEC_Stock_t stock;
+		uint8_t         record[CHCODEC_MAX_SIZE];
+		uint16_t        index = CHBANK_EMPTY;
+
+		Fetch(i, &stock);
+		if (!IsEmpty(stock.attributes)) {
+			const uint8_t size = CHCODEC_Encode(&stock, record);
+			if (size == 0 || offset + 1 + size > BANK_SIZE)
+				return 0;
+			index = offset;
+			bank[offset] = size;
+			memcpy(&bank[offset + 1], record, size);
+			offset += 1 + size;
+		}
+
+		bank[CHBANK_INDEX + (i * 2) + 0] = index & 0xFF;
+		bank[CHBANK_INDEX + (i * 2) + 1] = index >> 8;
+	}
+
+	return offset;
+}
+
+// bank[] over the channels in eeprom[], as CHBANK_Load() does it
+static bool Unpack(void)
+{
+	if (bank[0] != CHBANK_MAGIC_0 || bank[1] != CHBANK_MAGIC_1 || bank[2] != CHBANK_VERSION || bank[3] != CHBANK_CHANNELS)
+		return false;
+
+	for (unsigned int i = 0; i < CHBANK_CHANNELS; i++) {
+		const unsigned int offset = bank[CHBANK_INDEX + (i * 2)] | (bank[CHBANK_INDEX + (i * 2) + 1] << 8);
+		CHCODEC_Stock_t    stock;
+
+		if (offset == CHBANK_EMPTY) {
+			memset(&stock, 0, sizeof(stock));
+			memset(stock.data, 0xFF, sizeof(stock.data));
+			stock.attributes = 0xFF;
+		}
+		else if (offset < CHBANK_RECORDS || offset + 1 + bank[offset] > BANK_SIZE ||
+		         !CHCODEC_Decode(&bank[offset + 1], bank[offset], &stock)) {
+			fprintf(stderr, "channel %u: bad record\n", i + 1);
+			return false;
+		}
+
+		Place(i, &stock);
+	}
+
+	return true;
+}
+
+static bool Load(const char *pName, void *pBuffer, size_t Size)
+{
+	FILE *f = fopen(pName, "rb");
+	if (f == NULL) {
+		fprintf(stderr, "can't read %s\n", pName);
+		return false;
+	}
+	memset(pBuffer, 0xFF, Size);
+	const size_t n = fread(pBuffer, 1, Size, f);
+	fclose(f);
+	if (n < 0x1000) {
+		fprintf(stderr, "%s: too short\n", pName);
+		return false;
+	}
+	return true;
+}
+
+static bool Save(const char *pName, const void *pBuffer, size_t Size)
+{
+	FILE *f = fopen(pName, "wb");
+	if (f == NULL || fwrite(pBuffer, 1, Size, f) != Size) {
+		fprintf(stderr, "can't write %s\n", pName);
+		if (f != NULL)
+			fclose(f);
+		return false;
+	}
+	fclose(f);
+	return true;
+}
+
+static void MakeChannel(unsigned int Channel, uint32_t Frequency, uint32_t Offset, uint8_t Direction, uint8_t Modulation,
+                        uint8_t RxType, uint8_t RxCode, uint8_t TxType, uint8_t TxCode, uint8_t Band, const char *pName)
+{
+	uint8_t *p = &eeprom[Channel * 16];
+
+	memset(p, 0, 16);
+	for (unsigned int i = 0; i < 4; i++) {
+		p[i]     = Frequency >> (i * 8);
+		p[4 + i] = Offset >> (i * 8);
+	}
+	p[8]  = RxCode;
+	p[9]  = TxCode;
+	p[10] = (TxType << 4) | RxType;
+	p[11] = (Modulation << 4) | Direction;
+	p[12] = 0x04;   // high power
+	p[13] = 0x00;
+	p[14] = 5;      // 12.5kHz
+	memset(&eeprom[0x0F50 + (Channel * 16)], 0, 16);
+	memcpy(&eeprom[0x0F50 + (Channel * 16)], pName, strnlen(pName, 10));
+	eeprom[0x0D60 + Channel] = 0xC0 | Band;
+}
+
+// a made up but typical memory list
+static void MakeList(void)
+{
+	static const char * const towns[] = {"LONDON", "LEEDS", "YORK", "BATH", "DERBY", "HULL", "OXFORD", "ELY"};
+	unsigned int ch = 0;
+	char         name[16];
+
+	memset(eeprom, 0xFF, sizeof(eeprom));
+
+	for (unsigned int i = 0; i < 40; i++) {   // 2m and 70cm repeaters with CTCSS
+		const bool     uhf  = i & 1;
+		const uint32_t freq = uhf ? 43060000 + (i * 2500) : 14560000 + (i * 1250);
+		snprintf(name, sizeof(name), "GB3%s", towns[i % 8]);
+		MakeChannel(ch++, freq, uhf ? 760000 : 60000, 2, 0, 0, 0, 1, i % 50, uhf ? 5 : 2, name);
+	}
+	for (unsigned int i = 0; i < 16; i++) {   // PMR446
+		snprintf(name, sizeof(name), "PMR %u", i + 1);
+		MakeChannel(ch++, 44600625 + (i * 1250), 0, 0, 0, 0, 0, 0, 0, 5, name);
+	}
+	for (unsigned int i = 0; i < 22; i++) {   // FRS/GMRS
+		const uint32_t freq = (i < 7) ? 46256250 + (i * 2500) : (i < 14) ? 46756250 + ((i - 7) * 2500) : 46255000 + ((i - 14) * 2500);
+		snprintf(name, sizeof(name), "%s%u", (i < 14) ? "FRS" : "GMRS", i + 1);
+		MakeChannel(ch++, freq, 0, 0, 0, 0, 0, 0, 0, 5, name);
+	}
+	for (unsigned int i = 0; i < 30; i++) {   // airband, 8.33kHz spacing, AM
+		snprintf(name, sizeof(name), "%s %u", (i % 3) ? "TWR" : "ATIS", 100 + i);
+		MakeChannel(ch++, 11800000 + (i * 83333 / 10), 0, 0, 1, 0, 0, 0, 0, 1, name);
+	}
+	for (unsigned int i = 0; i < 20; i++) {   // marine duplex
+		snprintf(name, sizeof(name), "MAR CH%02u", i + 60);
+		MakeChannel(ch++, 16062500 + (i * 5000), 460000, 1, 0, 0, 0, 0, 0, 2, name);
+	}
+	for (unsigned int i = 0; i < 20; i++) {   // DCS simplex, lower case and odd names
+		snprintf(name, sizeof(name), "Local %c%u", 'a' + i, i);
+		MakeChannel(ch++, 43350000 + (i * 1250), 0, 0, 0, 2, i * 5, 3, i * 5, 5, name);
+	}
+}
+
+static bool Test(void)
+{
+	unsigned int channels = 0;
+	unsigned int bytes    = 0;
+	unsigned int raw      = 0;
+	unsigned int largest  = 0;
+	unsigned int failed   = 0;
+
+	for (unsigned int i = 0; i < CHBANK_CHANNELS; i++) {
+		CHCODEC_Stock_t stock;
+		CHCODEC_Stock_t back;
+		uint8_t         record[CHCODEC_MAX_SIZE];
+
+		Fetch(i, &stock);
+		if (IsEmpty(stock.attributes))
+			continue;
+
+		const uint8_t size = CHCODEC_Encode(&stock, record);
+
+		// names compare up to where they end
+		char name[sizeof(stock.name)];
+		memcpy(name, stock.name, sizeof(name));
+		for (unsigned int k = 0, end = 0; k < sizeof(name); k++) {
+			if (name[k] == 0x00 || name[k] == (char)0xFF)
+				end = 1;
+			if (end)
+				name[k] = 0;
+		}
+
+		if (size == 0 || !CHCODEC_Decode(record, size, &back) || memcmp(stock.data, back.data, sizeof(stock.data)) != 0 ||
+		    memcmp(name, back.name, sizeof(name)) != 0 || stock.attributes != back.attributes) {
+			printf("channel %u doesn't come back the same\n", i + 1);
+			failed++;
+			continue;
+		}
+
+		channels++;
+		bytes += size;
+		raw   += record[1] & 1;
+		if (size > largest)
+			largest = size;
+	}
+
+	const unsigned int used = Pack();
+	printf("%u channels, %.1f bytes a channel on average (stock 33), largest %u, %u raw\n",
+		channels, channels ? (double)bytes / channels : 0.0, largest, raw);
+	printf("bank %u of %u bytes%s\n", used, BANK_SIZE, used ? "" : ", doesn't fit");
+
+	// and the whole bank back over a copy
+	static uint8_t copy[EEPROM_SIZE];
+	memcpy(copy, eeprom, sizeof(copy));
+	if (used == 0 || !Unpack()) {
+		failed++;
+	}
+	else {
+		for (unsigned int i = 0; i < CHBANK_CHANNELS; i++) {
+			if (IsEmpty(copy[0x0D60 + i]) ? !IsEmpty(eeprom[0x0D60 + i]) :
+			    memcmp(&copy[i * 16], &eeprom[i * 16], 16) != 0 || copy[0x0D60 + i] != eeprom[0x0D60 + i]) {
+				printf("channel %u: bank round trip differs\n", i + 1);
+				failed++;
+			}
+		}
+	}
+
+	printf("%u failed\n", failed);
+	return failed == 0;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc == 4 && strcmp(argv[1], "pack") == 0) {
+		if (!Load(argv[2], eeprom, sizeof(eeprom)))
+			return 1;
+		const unsigned int used = Pack();
+		if (used == 0) {
+			fprintf(stderr, "the channels don't fit in a %u byte bank\n", BANK_SIZE);
+			return 1;
+		}
+		printf("%u of %u bytes\n", used, BANK_SIZE);
+		return Save(argv[3], bank, sizeof(bank)) ? 0 : 1;
+	}
+
+	if (argc == 4 && strcmp(argv[1], "unpack") == 0) {
+		if (!Load(argv[2], bank, sizeof(bank)) || !Load(argv[3], eeprom, sizeof(eeprom)))
+			return 1;
+		if (!Unpack()) {
+			fprintf(stderr, "%s: not a channel bank\n", argv[2]);
+			return 1;
+		}
+		return Save(argv[3], eeprom, sizeof(eeprom)) ? 0 : 1;
+	}
+
+	if ((argc == 2 || argc == 3) && strcmp(argv[1], "test") == 0) {
+		if (argc == 3) {
+			if (!Load(argv[2], eeprom, sizeof(eeprom)))
+				return 1;
+		}
+		else {
+			MakeList();
+		}
+		return Test() ? 0 : 1;
+	}
+
+	fprintf(stderr, "usage: %s pack eeprom.bin bank.bin\n"
+	                "       %s unpack bank.bin eeprom.bin\n"
+	                "       %s test [eeprom.bin]\n", argv[0], argv[0], argv[0]);
+	return 1;
+}
@@ -0,0 +1,676 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// FSK packet layer loopback test
+//
+// runs the real app/fsk.c on the PC against a mocked BK4819 FSK modem. The
+// frames one radio puts on air (with their timing at 1200 baud) are fed,
+// 4 words per FIFO almost full interrupt, into the RX side of another, and
+// what comes out is checked against what went in. Prints the effective
+// throughput (payload bytes per second from first key up to last PA off).
+//
+// build and run (from the repo root):
+//
+//   make fsk_sim
+//   ./fsk_sim                  mixed frame sizes, with stock aircopy packets
+//   ./fsk_sim -l 66 -n 200     200 full size frames
+//   ./fsk_sim -e 0.0005        one bit error in 2000
+//   ./fsk_sim -a -d 0.2        aircopy, one frame in 5 lost either way
+//
+// exits with 1 if a frame came out different from what was sent, or if
+// frames went missing on an error free channel
+//
+// with -a it runs the real app/aircopy.c on two radios instead, this
+// process is the sender and a fork() of it the receiver, each with its own
+// copy of the fsk.c/aircopy.c state, in step with each other 10ms at a
+// time and swapping what they put on air through pipes. Frames are lost
+// at random (-d) in both directions, and the receiver's main loop is held
+// up 8ms for every EEPROM write like the real one. Exits with 1 unless the
+// resend passes end with the receiver holding the complete image, which
+// they do up to about -d 0.3
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "app/aircopy.h"
+#include "app/fsk.h"
+#include "driver/bk4819.h"
+#include "driver/crc.h"
+#include "driver/eeprom.h"
+#include "frequencies.h"
+#include "misc.h"
+#include "radio.h"
+#include "ui/inputbox.h"
+#include "ui/ui.h"
+
+#define TICK_us          10000u
+#define BAUD             1200u
+#define BYTE_us          (8000000u / BAUD)
+#define OVERHEAD_BYTES   (7 + 4 + 2)     // preamble, sync word and the modem's CRC
+#define RX_PACKET_WORDS  36              // what the layer sets REG_5D to for RX
+#define MAX_FRAMES       4096
+
+static uint32_t now_us;
+
+static uint32_t rand_state = 12345;
+
+static uint32_t sim_rand(void)
+{
+	rand_state = rand_state * 1103515245u + 12345u;
+	return rand_state >> 8;
+}
+
+// *************************************************************
+// the firmware bits fsk.c needs
+
+uint16_t CRC_Calculate(const void *pBuffer, uint16_t Size)
+{	// the DP32G030 CRC unit as set up by CRC_Init(), CRC-16/XMODEM
+	const uint8_t *pData = pBuffer;
+	uint16_t crc = 0;
+	while (Size--) {
+		crc ^= *pData++ << 8;
+		for (unsigned i = 0; i < 8; i++)
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+	}
+	return crc;
+}
+
+// *************************************************************
+// the air, a list of transmitted frames
+
+typedef struct {
+	uint32_t start_us;     // first bit of the preamble
+	uint32_t end_us;
+	uint8_t  words;
+	uint16_t data[RX_PACKET_WORDS];
+} AirFrame_t;
+
+static AirFrame_t air[MAX_FRAMES];
+static unsigned   air_count;
+
+// *************************************************************
+// mocked BK4819 FSK modem, TX side
+
+static uint16_t tx_fifo[64];
+static unsigned tx_words;
+static bool     tx_on;
+static bool     pa_on;
+static unsigned key_ups;
+static uint32_t first_key_up_us = UINT32_MAX;
+static uint32_t last_pa_off_us;
+static uint32_t pa_on_us;
+static uint32_t pa_on_since_us;
+
+void RADIO_SetTxParameters(void)
+{
+	if (!pa_on) {
+		key_ups++;
+		pa_on_since_us = now_us;
+		if (first_key_up_us == UINT32_MAX)
+			first_key_up_us = now_us;
+	}
+	pa_on = true;
+}
+
+void BK4819_SetupPowerAmplifier(const uint8_t bias, const uint32_t frequency)
+{
+	(void)frequency;
+	if (bias == 0 && pa_on) {
+		pa_on = false;
+		pa_on_us += now_us - pa_on_since_us;
+		last_pa_off_us = now_us;
+	}
+}
+
+void BK4819_LoadFSKTxData(const uint16_t *pData, const unsigned int Words)
+{
+	if (Words > ARRAY_SIZE(tx_fifo)) {
+		fprintf(stderr, "TX FIFO overflow, %u words\n", Words);
+		exit(1);
+	}
+	memcpy(tx_fifo, pData, Words * 2);
+	tx_words = Words;
+}
+
+void BK4819_StartFSKTransmit(void)
+{
+	if (!pa_on) {
+		fprintf(stderr, "%u ms: FSK TX with the PA off\n", now_us / 1000);
+		exit(1);
+	}
+	if (air_count >= MAX_FRAMES) {
+		fprintf(stderr, "too many frames\n");
+		exit(1);
+	}
+
+	AirFrame_t *f = &air[air_count++];
+	f->start_us = now_us;
+	f->end_us   = now_us + (OVERHEAD_BYTES + tx_words * 2) * BYTE_us;
+	f->words    = tx_words;
+	memcpy(f->data, tx_fifo, tx_words * 2);
+	tx_on = true;
+}
+
+// *************************************************************
+// mocked BK4819 FSK modem, RX side
+
+static uint16_t rx_fifo[RX_PACKET_WORDS];
+static unsigned rx_fifo_len;       // words waiting to be read
+static unsigned rx_words;          // words of the current packet the modem took in
+static bool     rx_listening;      // RX on, waiting for a sync word
+static bool     rx_in_packet;      // got a sync word
+static unsigned rx_restarts;
+
+void BK4819_PrepareFSKReceive(const unsigned int MaxWords)
+{
+	if (MaxWords != RX_PACKET_WORDS) {
+		fprintf(stderr, "unexpected RX packet length %u\n", MaxWords);
+		exit(1);
+	}
+	BK4819_RestartFSKReceive();
+}
+
+void BK4819_RestartFSKReceive(void)
+{
+	rx_fifo_len  = 0;
+	rx_words     = 0;
+	rx_listening = true;
+	rx_in_packet = false;
+	rx_restarts++;
+}
+
+uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
+{
+	if (Register != BK4819_REG_5F || rx_fifo_len == 0) {
+		fprintf(stderr, "unexpected register read, REG_%02X\n", Register);
+		exit(1);
+	}
+	const uint16_t word = rx_fifo[0];
+	memmove(&rx_fifo[0], &rx_fifo[1], --rx_fifo_len * 2);
+	return word;
+}
+
+// modem takes in one word, returns the interrupt status bits it raises
+static uint16_t rx_word(const uint16_t word)
+{
+	if (rx_fifo_len >= ARRAY_SIZE(rx_fifo)) {
+		fprintf(stderr, "RX FIFO overflow\n");
+		exit(1);
+	}
+	rx_fifo[rx_fifo_len++] = word;
+	uint16_t status = (rx_fifo_len >= 4) ? BK4819_REG_02_FSK_FIFO_ALMOST_FULL : 0;
+	if (++rx_words >= RX_PACKET_WORDS) {
+		status |= BK4819_REG_02_FSK_RX_FINISHED;
+		rx_in_packet = false;
+		rx_listening = false;    // needs a restart
+	}
+	return status;
+}
+
+// stubs
+void BK4819_SetupFSK(void) {}
+void BK4819_ResetFSK(void) { rx_listening = false; rx_in_packet = false; }
+void BK4819_ToggleGpioOut(BK4819_GPIO_PIN_t Pin, bool bSet) { (void)Pin; (void)bSet; }
+
+// *************************************************************
+// frames we send
+
+typedef struct {
+	uint8_t type;
+	uint8_t length;
+	uint8_t payload[FSK_LEGACY_PAYLOAD];
+} SentFrame_t;
+
+static SentFrame_t sent[MAX_FRAMES];
+static unsigned    sent_count;
+
+static void make_frame(SentFrame_t *f, const int fixed_length, const unsigned n)
+{
+	if (fixed_length < 0 && n % 8 == 7) {
+		f->type   = FSK_TYPE_LEGACY;
+		f->length = FSK_LEGACY_PAYLOAD;
+	}
+	else {
+		f->type   = (n & 1) ? FSK_TYPE_MESSAGE : FSK_TYPE_BEACON;
+		f->length = (fixed_length >= 0) ? (uint32_t)fixed_length : sim_rand() % (FSK_MAX_PAYLOAD + 1);
+	}
+	for (unsigned i = 0; i < f->length; i++)
+		f->payload[i] = sim_rand();
+}
+
+// *************************************************************
+// aircopy (-a), the rest of the firmware aircopy.c needs
+
+#define AIRCOPY_BYTES    0x1E00
+#define MAX_TICKS        (600u * 100u)     // 10 minutes
+#define STOP_TICKS       300u              // run on after the sender's done
+
+GUI_DisplayType_t             gRequestDisplayScreen;
+bool                          gUpdateDisplay;
+char                          gInputBox[8];
+uint8_t                       gInputBoxIndex;
+VFO_Info_t                   *gRxVfo;
+VFO_Info_t                   *gCurrentVfo;
+const freq_band_table_t       frequencyBandTable[1];
+
+void          GUI_DisplayScreen(void) {}
+void          INPUTBOX_Append(const KEY_Code_t Digit) { (void)Digit; }
+const char   *INPUTBOX_GetAscii(void) { return gInputBox; }
+unsigned long StrToUL(const char *str) { return strtoul(str, NULL, 10); }
+uint32_t      FREQUENCY_RoundToStep(uint32_t freq, uint16_t step) { (void)step; return freq; }
+int32_t       TX_freq_check(uint32_t Frequency) { (void)Frequency; return 0; }
+void          RADIO_ConfigureSquelchAndOutputPower(VFO_Info_t *pInfo) { (void)pInfo; }
+void          RADIO_SetupRegisters(bool switchToForeground) { (void)switchToForeground; }
+
+static uint8_t  eeprom[0x2000];
+static uint32_t busy_until_us;      // main loop held up by EEPROM writes
+
+void EEPROM_ReadBuffer(uint16_t Address, void *pBuffer, uint8_t Size)
+{
+	memcpy(pBuffer, &eeprom[Address], Size);
+}
+
+void EEPROM_WriteBuffer(uint16_t Address, const void *pBuffer)
+{
+	if (memcmp(&eeprom[Address], pBuffer, 8) == 0)
+		return;
+	memcpy(&eeprom[Address], pBuffer, 8);
+	busy_until_us = ((busy_until_us > now_us) ? busy_until_us : now_us) + 8000;
+}
+
+// frames from the other radio, and how far they've come in
+static AirFrame_t inbox[MAX_FRAMES];
+static unsigned   inbox_count;
+static unsigned   inbox_next;
+static unsigned   inbox_word;
+static unsigned   inbox_lost;
+static uint16_t   pending[64];      // interrupts raised while the main loop was busy
+static unsigned   pending_count;
+static uint32_t   drop_threshold;
+
+static void Interrupt(const uint16_t status, const uint32_t t)
+{
+	if (t < busy_until_us) {
+		if (pending_count < ARRAY_SIZE(pending))
+			pending[pending_count++] = status;
+		return;
+	}
+
+	for (unsigned i = 0; i < pending_count; i++)
+		FSK_HandleInterrupt(pending[i]);
+	pending_count = 0;
+
+	FSK_HandleInterrupt(status);
+}
+
+// the other radio's words that are in by 'until_us', the modem only syncs
+// on a frame when it was listening at its start, and some are lost anyway
+static void Deliver(const uint32_t until_us)
+{
+	while (inbox_next < inbox_count) {
+		const AirFrame_t *f = &inbox[inbox_next];
+		const uint32_t    t = f->start_us + (OVERHEAD_BYTES + (inbox_word + 1) * 2) * BYTE_us;
+
+		if (t > until_us)
+			break;
+
+		if (inbox_word == 0) {
+			const bool lost = (sim_rand() & 0xFFFFFF) < drop_threshold;
+			rx_in_packet = rx_listening && !rx_in_packet && !pa_on && !lost;
+			inbox_lost  += lost;
+		}
+
+		if (rx_in_packet)
+			Interrupt(rx_word(f->data[inbox_word]), t);
+
+		if (++inbox_word >= f->words) {
+			inbox_next++;
+			inbox_word = 0;
+		}
+	}
+
+	if (pending_count > 0 && until_us >= busy_until_us)
+		Interrupt(0, until_us);
+}
+
+static bool WriteAll(const int fd, const void *pData, size_t size)
+{
+	const uint8_t *p = pData;
+	while (size > 0) {
+		const ssize_t n = write(fd, p, size);
+		if (n <= 0)
+			return false;
+		p += n;
+		size -= n;
+	}
+	return true;
+}
+
+static bool ReadAll(const int fd, void *pData, size_t size)
+{
+	uint8_t *p = pData;
+	while (size > 0) {
+		const ssize_t n = read(fd, p, size);
+		if (n <= 0)
+			return false;
+		p += n;
+		size -= n;
+	}
+	return true;
+}
+
+static void MakeImage(uint8_t *pImage)
+{
+	for (unsigned i = 0; i < AIRCOPY_BYTES; i++)
+		pImage[i] = sim_rand();
+}
+
+static int RunAircopy(const double drop, const bool verbose)
+{
+	int      to_rx[2];
+	int      to_tx[2];
+	uint8_t  image[AIRCOPY_BYTES];
+
+	MakeImage(image);
+	drop_threshold = (uint32_t)(drop * 16777216.0);
+
+	if (pipe(to_rx) != 0 || pipe(to_tx) != 0) {
+		perror("pipe");
+		return 1;
+	}
+
+	fflush(stdout);
+	const pid_t child     = fork();
+	const bool  is_sender = child != 0;
+	if (child < 0) {
+		perror("fork");
+		return 1;
+	}
+
+	const int fd_out = is_sender ? to_rx[1] : to_tx[1];
+	const int fd_in  = is_sender ? to_tx[0] : to_rx[0];
+
+	if (is_sender)
+		memcpy(eeprom, image, sizeof(image));
+	else
+		memset(eeprom, 0xFF, sizeof(eeprom));
+
+	// both start on the aircopy screen, the receiver first
+	FSK_Init();
+	AIRCOPY_ProcessKeys(is_sender ? KEY_MENU : KEY_EXIT, true, false);
+
+	unsigned ticks      = 0;
+	unsigned stop_ticks = 0;
+	uint32_t done_us    = 0;
+	unsigned sent_air   = 0;
+
+	while (ticks++ < MAX_TICKS && stop_ticks < STOP_TICKS) {
+		Deliver(now_us + TICK_us);
+
+		if (tx_on && now_us >= air[air_count - 1].end_us) {
+			tx_on = false;
+			FSK_HandleInterrupt(BK4819_REG_02_FSK_TX_FINISHED);
+		}
+
+		// the 10ms slice, unless it's still stuck in an EEPROM write
+		if (now_us >= busy_until_us) {
+			if (is_sender && gAircopyState == AIRCOPY_TRANSFER)
+				AIRCOPY_SendMessage();
+			if (!is_sender)
+				AIRCOPY_ReceiveMessage();
+			FSK_TimeSlice10ms();
+		}
+
+		// what went on air this tick goes to the other radio
+		const uint32_t new_frames = air_count - sent_air;
+		const uint8_t  sender_done = is_sender && gAircopyState == AIRCOPY_COMPLETE;
+		uint32_t       peer_frames;
+		uint8_t        peer_done;
+
+		if (!WriteAll(fd_out, &new_frames, sizeof(new_frames)) ||
+		    !WriteAll(fd_out, &air[sent_air], new_frames * sizeof(air[0])) ||
+		    !WriteAll(fd_out, &sender_done, sizeof(sender_done)) ||
+		    !ReadAll(fd_in, &peer_frames, sizeof(peer_frames)) ||
+		    peer_frames > MAX_FRAMES - inbox_count ||
+		    !ReadAll(fd_in, &inbox[inbox_count], peer_frames * sizeof(inbox[0])) ||
+		    !ReadAll(fd_in, &peer_done, sizeof(peer_done))) {
+			fprintf(stderr, "%s: lost the other radio\n", is_sender ? "sender" : "receiver");
+			return 1;
+		}
+		sent_air     = air_count;
+		inbox_count += peer_frames;
+
+		if (sender_done || peer_done) {
+			if (stop_ticks++ == 0)
+				done_us = now_us;
+		}
+
+		now_us += TICK_us;
+	}
+
+	if (!is_sender) {
+		const bool complete = memcmp(eeprom, image, sizeof(image)) == 0;
+		printf("receiver             %u blocks, %u errors, %u frames lost, %s\n",
+			gAirCopyBlockNumber, gErrorsDuringAirCopy, inbox_lost, complete ? "image complete" : "IMAGE INCOMPLETE");
+		fflush(stdout);
+		_exit(complete ? 0 : 1);
+	}
+
+	int status = 1;
+	waitpid(child, &status, 0);
+
+	printf("sender               %u blocks the receiver has, %u resent, %u frames lost\n",
+		gAirCopyBlockNumber, gAirCopyResends, inbox_lost);
+	if (done_us > 0)
+		printf("done after           %.1f s (%.1f bytes/s)\n", done_us / 1e6, AIRCOPY_BYTES * 1e6 / done_us);
+	else
+		printf("sender never finished\n");
+	if (verbose)
+		printf("key ups              %u, PA on %.2f s\n", key_ups, pa_on_us / 1e6);
+
+	if (done_us == 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0 || gAirCopyBlockNumber != AIRCOPY_BYTES / 64)
+		return 1;
+
+	return 0;
+}
+
+// *************************************************************
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s [options]\n"
+		"\n"
+		"  -n n     frames to send (default 100)\n"
+		"  -l n     payload length, 0 to %u (default mixed sizes with stock aircopy packets)\n"
+		"  -e ber   bit error rate on the air (default 0)\n"
+		"  -a       aircopy between two radios instead\n"
+		"  -d p     aircopy, chance of a frame being lost (default 0)\n"
+		"  -v       print every frame\n",
+		name, FSK_MAX_PAYLOAD);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned frames       = 100;
+	int      fixed_length = -1;
+	double   ber          = 0;
+	bool     verbose      = false;
+	bool     aircopy      = false;
+	double   drop         = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-v") == 0)
+			verbose = true;
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			frames = strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+			fixed_length = strtol(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+			ber = strtod(argv[++i], NULL);
+		else if (strcmp(argv[i], "-a") == 0)
+			aircopy = true;
+		else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+			drop = strtod(argv[++i], NULL);
+		else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (frames == 0 || frames > MAX_FRAMES || fixed_length > FSK_MAX_PAYLOAD || ber < 0 || ber >= 1 || drop < 0 || drop >= 1) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (aircopy)
+		return RunAircopy(drop, verbose);
+
+	// ---- sender, keeps the TX queue topped up
+
+	FSK_Init();
+
+	uint32_t payload_bytes = 0;
+	while (sent_count < frames || FSK_TxBusy()) {
+		if (tx_on && now_us >= air[air_count - 1].end_us) {
+			tx_on = false;
+			FSK_HandleInterrupt(BK4819_REG_02_FSK_TX_FINISHED);
+		}
+
+		while (sent_count < frames) {
+			SentFrame_t *f = &sent[sent_count];
+			make_frame(f, fixed_length, sent_count);
+			if (!FSK_Send(f->type, f->payload, f->length))
+				break;
+			payload_bytes += f->length;
+			sent_count++;
+		}
+
+		FSK_TimeSlice10ms();
+		now_us += TICK_us;
+
+		if (now_us > 3600u * 1000000u) {
+			fprintf(stderr, "sender stuck\n");
+			return 1;
+		}
+	}
+
+	const uint32_t tx_time_us = last_pa_off_us - first_key_up_us;
+	uint32_t air_us = 0;
+	for (unsigned i = 0; i < air_count; i++)
+		air_us += air[i].end_us - air[i].start_us;
+
+	// ---- receiver, the same frames come in over the air
+
+	FSK_Init();
+	FSK_StartRx();
+
+	const uint32_t bit_threshold = (uint32_t)(ber * 16777216.0);
+	unsigned received  = 0;
+	unsigned corrupted = 0;
+	unsigned legacy_bad = 0;
+	uint32_t received_bytes = 0;
+	unsigned bit_errors = 0;
+	unsigned next      = 0;     // next frame expected
+	unsigned frame     = 0;     // frame on air
+	unsigned word      = 0;     // words of it delivered
+	uint32_t t         = air[0].start_us;
+
+	// deliver the air word by word, the modem only syncs on a frame when it
+	// was listening at its start
+	while (frame < air_count || rx_in_packet) {
+		uint16_t status = 0;
+
+		if (frame < air_count) {
+			const AirFrame_t *f = &air[frame];
+			if (t < f->start_us) {
+				if (rx_in_packet)    // still waiting for words of a frame that ended, noise
+					status = rx_word(sim_rand());
+				t = rx_in_packet ? t + 2 * BYTE_us : f->start_us;
+			}
+			else {
+				if (word == 0)
+					rx_in_packet = rx_listening && !rx_in_packet;
+				if (rx_in_packet) {
+					uint16_t w = f->data[word];
+					for (unsigned b = 0; b < 16; b++) {
+						if ((sim_rand() & 0xFFFFFF) < bit_threshold) {
+							w ^= 1u << b;
+							bit_errors++;
+						}
+					}
+					status = rx_word(w);
+				}
+				t += 2 * BYTE_us;
+				if (++word >= f->words) {
+					frame++;
+					word = 0;
+				}
+			}
+		}
+		else {
+			status = rx_word(sim_rand());
+			t += 2 * BYTE_us;
+		}
+
+		if (status != 0)
+			FSK_HandleInterrupt(status);
+
+		// the main loop picks frames up every tick or so
+		FSK_Frame_t rx;
+		while (FSK_Receive(&rx)) {
+			// frames can go missing, not come out of order
+			unsigned match = next;
+			while (match < sent_count && match < next + 256) {
+				const SentFrame_t *f = &sent[match];
+				if (f->type == rx.type && f->length == rx.length && memcmp(f->payload, rx.payload, rx.length) == 0)
+					break;
+				match++;
+			}
+			const bool same = match < sent_count && match < next + 256;
+			if (verbose)
+				printf("%8.2f s  type %3u  seq %3u  length %2u  %s\n", t / 1e6, rx.type, rx.seq, rx.length, same ? "ok" : "BAD");
+			if (same) {
+				received++;
+				received_bytes += rx.length;
+				next = match + 1;
+			}
+			else if (rx.type == FSK_TYPE_LEGACY)
+				legacy_bad++;    // no CRC of ours, aircopy checks its own
+			else
+				corrupted++;
+		}
+	}
+
+	printf("frames sent          %u, %u payload bytes\n", sent_count, payload_bytes);
+	printf("frames received      %u ok, %u bad, %u lost\n", received, corrupted, sent_count - received - corrupted - legacy_bad);
+	printf("stock aircopy frames %u with bit errors, passed on for the app to check\n", legacy_bad);
+	printf("RX errors/dropped    %u/%u (%u bit errors on air)\n", gFSK_Stats.rx_errors, gFSK_Stats.rx_dropped, bit_errors);
+	printf("key ups              %u, PA on %.2f s\n", key_ups, pa_on_us / 1e6);
+	printf("time on air          %.2f s of %.2f s\n", air_us / 1e6, tx_time_us / 1e6);
+	printf("throughput           %.1f bytes/s sent, %.1f bytes/s of it received (raw channel %u bytes/s)\n",
+		payload_bytes * 1e6 / tx_time_us, received_bytes * 1e6 / tx_time_us, BAUD / 8);
+
+	if (corrupted > 0 || (ber == 0 && received != sent_count))
+		return 1;
+
+	return 0;
+}
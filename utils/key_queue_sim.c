@@ -0,0 +1,166 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// key event queue test
+//
+// runs the real key_queue.c on the PC against scripted keypad readings
+// (taps, contact bounce, fast typing, roll-over from one key to the next,
+// long presses, UP/DOWN repeat, a main loop that only gets round every
+// few ticks) and checks the events that come out, with their time stamps
+//
+// build and run (from the repo root):
+//
+//   make key_queue_sim
+//   ./key_queue_sim            -v prints every event
+//
+// exits with 1 if any script gives different events from what's expected
+//
+// events print as <type><key>@<tick>: P press, L long, T repeat, R release,
+// r release after a long press
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "key_queue.h"
+
+#define X KEY_INVALID
+
+typedef struct {
+	uint8_t  key;
+	uint16_t ticks;
+} Seg_t;
+
+typedef struct {
+	const char  *name;
+	Seg_t        seg[8];
+	uint8_t      step;         // the main loop gets round every so many ticks
+	uint8_t      long_press;   // 0 for the default
+	const char  *expect;
+} Script_t;
+
+static const Script_t scripts[] = {
+	{"tap",        {{X, 10}, {KEY_5, 5}, {X, 10}}, 1, 0,
+		"P5@10 R5@15"},
+	{"bounce",     {{KEY_5, 1}, {X, 1}, {KEY_5, 1}, {X, 20}}, 1, 0,
+		""},
+	{"bounce+tap", {{KEY_5, 1}, {X, 1}, {KEY_5, 6}, {X, 20}}, 1, 0,
+		"P5@2 R5@8"},
+	{"typing",     {{KEY_1, 4}, {X, 3}, {KEY_2, 4}, {X, 3}, {KEY_3, 4}, {X, 10}}, 1, 0,
+		"P1@0 R1@4 P2@7 R2@11 P3@14 R3@18"},
+	{"roll-over",  {{KEY_1, 10}, {KEY_2, 10}, {X, 10}}, 1, 0,
+		"P1@0 R1@10 P2@10 R2@20"},
+	{"long",       {{KEY_MENU, 60}, {X, 10}}, 1, 0,
+		"PA@0 LA@40 rA@60"},
+	{"repeat",     {{KEY_UP, 70}, {X, 10}}, 1, 0,
+		"PB@0 LB@40 TB@48 TB@56 TB@64 rB@70"},
+	{"slow loop",  {{X, 3}, {KEY_7, 10}, {X, 10}}, 5, 0,
+		"P7@5 R7@15"},
+	{"long 1s",    {{KEY_MENU, 60}, {X, 10}, {KEY_MENU, 110}, {X, 10}}, 1, 100,
+		"PA@0 RA@60 PA@70 LA@170 rA@180"},
+};
+
+static bool verbose;
+
+static void Format(char *p, const KEY_Event_t *pEvent)
+{
+	static const char type[] = "PLTR";
+	static const char key[]  = "0123456789ABCD*F";
+
+	sprintf(p, "%c%c@%u",
+		(pEvent->type == KEY_EVENT_RELEASE && pEvent->held) ? 'r' : type[pEvent->type],
+		(pEvent->key < 16) ? key[pEvent->key] : '?',
+		(unsigned int)pEvent->time_10ms);
+}
+
+static bool Run(const Script_t *pScript)
+{
+	char         got[256] = "";
+	KEY_Event_t  event;
+	unsigned int t   = 0;
+
+	gKeyTiming.long_press_10ms = pScript->long_press ? pScript->long_press : KEYQ_LONG_PRESS_DEFAULT;
+	KEYQ_Reset(KEY_INVALID);
+
+	for (const Seg_t *pSeg = pScript->seg; pSeg->ticks; pSeg++) {
+		for (const unsigned int end = t + pSeg->ticks; t < end; t++) {
+			if (t % pScript->step)
+				continue;
+
+			KEYQ_Scan(pSeg->key, t);
+
+			while (KEYQ_Get(&event)) {
+				char *p = got + strlen(got);
+				if (p != got)
+					*p++ = ' ';
+				Format(p, &event);
+			}
+		}
+	}
+
+	const bool ok = strcmp(got, pScript->expect) == 0;
+
+	if (!ok || verbose)
+		printf("%-11s %s\n", pScript->name, got);
+	if (!ok)
+		printf("%-11s %s  <- expected\n", "", pScript->expect);
+
+	return ok;
+}
+
+static bool QueueFull(void)
+{
+	KEY_Event_t  event = {.key = KEY_9, .type = KEY_EVENT_PRESS};
+	unsigned int put   = 0;
+	unsigned int got   = 0;
+
+	KEYQ_Reset(KEY_INVALID);
+
+	for (unsigned int i = 0; i < KEYQ_LEN + 4; i++) {
+		event.time_10ms = i;
+		put += KEYQ_Put(&event);
+	}
+
+	while (KEYQ_Get(&event)) {
+		if (event.time_10ms != got)
+			break;
+		got++;
+	}
+
+	const bool ok = put == KEYQ_LEN - 1 && got == put;
+
+	if (!ok || verbose)
+		printf("%-11s %u put, %u got in order\n", "queue full", put, got);
+
+	return ok;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int failed = 0;
+
+	verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+
+	for (unsigned int i = 0; i < sizeof(scripts) / sizeof(scripts[0]); i++)
+		failed += !Run(&scripts[i]);
+
+	failed += !QueueFull();
+
+	printf("%u of %u failed\n", failed, (unsigned int)(sizeof(scripts) / sizeof(scripts[0])) + 1);
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,240 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// offline battery save simulator
+//
+// runs the real POWERSAVE_NextSleep_10ms() from power_save.c against a
+// synthetic channel, side by side with the stock fixed ratio, and prints the
+// RX duty cycle, the estimated battery life and how late calls were heard
+//
+// build and run (from the repo root):
+//
+//   make power_save_sim
+//   ./power_save_sim                 all ratios, 4 conversations an hour
+//   ./power_save_sim -c 20 -r 4      busier channel, 1:4 only
+//
+// the policy's limits can be overridden when building, eg.
+//
+//   make power_save_sim POWER_SAVE_SIM_FLAGS="-DPOWERSAVE_PREAMBLE_10ms=30"
+//
+// traffic model: conversations start at random (Poisson, -c per hour), each
+// has a random number of overs (1 to -o) of 2 to 15 seconds, separated by
+// 1 to 5 second gaps. The radio follows the firmware's state machine: RX
+// while there's a carrier, foreground for battery_save_count_10ms after
+// it, then power save with power_save1_10ms RX windows between sleeps.
+// The currents are rough UV-K5 figures, change them with -i/-s/-b
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "power_save.h"
+
+#define HOURS              24
+#define TICKS              (HOURS * 3600 * 100)
+#define FOREGROUND_10ms    1000     // battery_save_count_10ms
+
+static double   convPerHour = 4.0;
+static int      maxOvers    = 6;
+static double   rxCurrent   = 38.0;  // mA, BK4819 RX on, display and backlight off
+static double   sleepCurrent= 12.0;  // mA, BK4819 asleep
+static double   battery     = 1600;  // mAh
+static unsigned seed        = 1;
+
+typedef struct {
+	uint32_t start;
+	uint32_t end;
+} Over_t;
+
+static Over_t   *overs;
+static unsigned  overCount;
+
+static uint32_t Random(void)
+{
+	seed = seed * 1103515245u + 12345u;
+	return (seed >> 8) & 0xFFFFFF;
+}
+
+static double Uniform(void)
+{
+	return (Random() + 0.5) / 16777216.0;
+}
+
+static uint32_t Between(uint32_t lo, uint32_t hi)
+{
+	return lo + Random() % (hi - lo + 1);
+}
+
+static void MakeTraffic(void)
+{
+	const double meanGap = 360000.0 / convPerHour;   // 10ms ticks
+	uint32_t     t       = 0;
+	unsigned     size    = 0;
+
+	overCount = 0;
+
+	while (true) {
+		t += (uint32_t)(-meanGap * log(Uniform()));
+
+		const int n = Between(1, maxOvers);
+		for (int i = 0; i < n; i++) {
+			if (t >= TICKS)
+				return;
+			if (overCount == size) {
+				size  = size ? size * 2 : 256;
+				overs = realloc(overs, size * sizeof(*overs));
+			}
+			overs[overCount].start = t;
+			overs[overCount].end   = t + Between(200, 1500);
+			t = overs[overCount].end + Between(100, 500);
+			overCount++;
+		}
+	}
+}
+
+typedef struct {
+	uint64_t rxTicks;
+	uint64_t sleepTicks;
+	uint64_t latencySum;
+	uint32_t heard;
+	uint32_t late;        // lost more than POWERSAVE_PREAMBLE_10ms
+	uint32_t worst;
+} Result_t;
+
+static Result_t Run(const uint8_t ratio, const bool adaptive)
+{
+	enum { FOREGROUND, SLEEP, WINDOW, RX } state = FOREGROUND;
+	uint32_t timer = FOREGROUND_10ms;
+	unsigned next  = 0;
+	Result_t r;
+
+	memset(&r, 0, sizeof(r));
+	POWERSAVE_Activity();   // as if the channel was just busy
+
+	for (uint32_t t = 0; t < TICKS; t++) {
+		while (next < overCount && overs[next].end <= t)
+			next++;
+		const bool carrier = next < overCount && overs[next].start <= t;
+
+		if (carrier && state != RX && state != SLEEP) {
+			const uint32_t latency = t - overs[next].start;
+			r.latencySum += latency;
+			r.heard++;
+			if (latency > POWERSAVE_PREAMBLE_10ms)
+				r.late++;
+			if (latency > r.worst)
+				r.worst = latency;
+			if (adaptive)
+				POWERSAVE_Activity();
+			state = RX;
+		}
+
+		if (state == SLEEP)
+			r.sleepTicks++;
+		else
+			r.rxTicks++;
+
+		switch (state) {
+			case RX:
+				if (!carrier) {
+					state = FOREGROUND;
+					timer = FOREGROUND_10ms;
+				}
+				break;
+
+			case FOREGROUND:
+			case WINDOW:
+				if (--timer == 0) {
+					state = SLEEP;
+					timer = adaptive ? POWERSAVE_NextSleep_10ms(ratio) : ratio * POWERSAVE_WAKE_10ms;
+				}
+				break;
+
+			case SLEEP:
+				if (--timer == 0) {
+					state = WINDOW;
+					timer = POWERSAVE_WAKE_10ms;
+				}
+				break;
+		}
+	}
+
+	return r;
+}
+
+static void Print(const char *name, const Result_t *r, const double baseHours)
+{
+	const double mA    = (r->rxTicks * rxCurrent + r->sleepTicks * sleepCurrent) / TICKS;
+	const double hours = battery / mA;
+
+	printf("  %-9s RX %5.1f%%  %5.2fmA  %6.1fh", name, 100.0 * r->rxTicks / TICKS, mA, hours);
+	if (baseHours > 0)
+		printf(" (%+5.1f%%)", 100.0 * (hours - baseHours) / baseHours);
+	else
+		printf("         ");
+	printf("  latency avg %4.0fms max %4ums  late %4.1f%%\n",
+		r->heard ? 10.0 * r->latencySum / r->heard : 0.0,
+		r->worst * 10,
+		r->heard ? 100.0 * r->late / r->heard : 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+	int ratio = 0;
+
+	for (int i = 1; i < argc - 1; i++) {
+		if      (!strcmp(argv[i], "-c")) convPerHour  = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-o")) maxOvers     = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-r")) ratio        = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-i")) rxCurrent    = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-s")) sleepCurrent = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-b")) battery      = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-x")) seed         = atoi(argv[++i]);
+	}
+
+	if (maxOvers < 1 || convPerHour <= 0 || ratio < 0 || ratio > 4) {
+		fprintf(stderr, "usage: %s [-c conversations/hour] [-o max overs] [-r ratio 1-4]"
+		                " [-i RX mA] [-s sleep mA] [-b battery mAh] [-x seed]\n", argv[0]);
+		return 1;
+	}
+
+	MakeTraffic();
+
+	printf("%u overs in %u hours, %.1f conversations/hour, RX %.0fmA, sleep %.0fmA, %.0fmAh\n",
+		overCount, HOURS, convPerHour, rxCurrent, sleepCurrent, battery);
+	printf("adaptive: %ums to %ums sleeps, late = lost more than %ums, limit %u%%\n\n",
+		POWERSAVE_MIN_SLEEP_10ms * 10, POWERSAVE_MAX_SLEEP_10ms * 10,
+		POWERSAVE_PREAMBLE_10ms * 10, POWERSAVE_MISS_PERCENT);
+
+	for (int n = 1; n <= 4; n++) {
+		if (ratio && n != ratio)
+			continue;
+
+		const Result_t fixed    = Run(n, false);
+		const Result_t adaptive = Run(n, true);
+		const double   mA       = (fixed.rxTicks * rxCurrent + fixed.sleepTicks * sleepCurrent) / TICKS;
+
+		printf("1:%d\n", n);
+		Print("fixed", &fixed, 0);
+		Print("adaptive", &adaptive, battery / mA);
+	}
+
+	free(overs);
+	return 0;
+}
@@ -0,0 +1,271 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// software tone decoder test
+//
+// runs the real app/tone_decoder.c on the PC against synthetic AF: DTMF,
+// ZVEI1 and CCIR 5-tone sequences and 1750Hz bursts at different speeds,
+// signal to noise ratios and frequency errors, and plain noise for the
+// false decodes. Prints the symbols that went wrong in each case
+//
+// build and run (from the repo root):
+//
+//   make tone_decoder_sim
+//   ./tone_decoder_sim             -v prints an SNR sweep as well
+//
+// exits with 1 if any case decodes wrong or noise decodes as anything
+//
+// the AF is 8kHz samples on the decoder's +/-2047 scale. A tone's level is
+// its peak amplitude, SNR is the power of the tone(s) over the power of
+// white noise across the whole 0..4kHz, so a 6dB SNR is a lot noisier in
+// the decoder's filters than on a real receiver with its audio filtering
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "app/tone_decoder.h"
+
+#define RATE            TONE_DECODER_SAMPLE_RATE
+#define TRIALS          20        // sequences per case, each with its own noise and timing
+
+static const uint16_t dtmf_row[4] = {697, 770, 852, 941};
+static const uint16_t dtmf_col[4] = {1209, 1336, 1477, 1633};
+static const char     dtmf_keys[] = "123A456B789C*0#D";
+
+// digits 0-9, then the repeat tone
+static const uint16_t zvei1_tones[11] = {2400, 1060, 1160, 1270, 1400, 1530, 1670, 1830, 2000, 2200, 2600};
+static const uint16_t ccir_tones[11]  = {1981, 1124, 1197, 1275, 1358, 1446, 1540, 1640, 1747, 1860, 2110};
+
+static bool     verbose;
+static uint32_t seed = 1;
+
+static double Uniform(void)
+{
+	seed = seed * 1103515245u + 12345u;
+	return ((seed >> 8) + 0.5) / 16777216.0;
+}
+
+static double Gauss(void)
+{
+	return sqrt(-2.0 * log(Uniform())) * cos(2.0 * M_PI * Uniform());
+}
+
+// *************************************************************
+// the AF going into the decoder
+
+static double   phase[2];
+static double   sigma;           // noise
+static char     got[128];
+static unsigned got_count;
+
+static void Push(double x)
+{
+	x += sigma * Gauss();
+	if (x > 2047)
+		x = 2047;
+	else if (x < -2047)
+		x = -2047;
+
+	TONE_DECODER_PushSample((int16_t)lrint(x));
+
+	TONE_DECODER_Mode_t mode;
+	char                symbol;
+	while ((symbol = TONE_DECODER_GetSymbol(&mode)) != 0)
+		if (got_count < sizeof(got) - 1)
+			got[got_count++] = symbol;
+}
+
+// two tones (f2 = 0 for one) for ms milliseconds
+static void Tone(double f1, double f2, double level, unsigned ms)
+{
+	for (unsigned i = 0; i < ms * (RATE / 1000); i++) {
+		double x = level * sin(phase[0]);
+		phase[0] += 2.0 * M_PI * f1 / RATE;
+		if (f2 > 0) {
+			x += level * sin(phase[1]);
+			phase[1] += 2.0 * M_PI * f2 / RATE;
+		}
+		Push(x);
+	}
+}
+
+static void Start(uint8_t modes, double signal_power, double snr_db)
+{
+	TONE_DECODER_Init(modes);
+	sigma     = sqrt(signal_power / pow(10.0, snr_db / 10.0));
+	got_count = 0;
+	memset(got, 0, sizeof(got));
+
+	// a random start so the tones fall anywhere in the 20ms blocks
+	Tone(0, 0, 0, 10 + Uniform() * 40);
+}
+
+// frequency error of each tone, +/- error percent
+static double Skew(double f, double error)
+{
+	return f * (1.0 + ((Uniform() < 0.5) ? -error : error) / 100.0);
+}
+
+// *************************************************************
+// the cases
+
+#define LEVEL           600.0    // peak of each tone
+
+static unsigned RunDTMF(const char *pKeys, unsigned tone_ms, unsigned gap_ms, double snr, double error)
+{
+	unsigned wrong = 0;
+
+	for (unsigned t = 0; t < TRIALS; t++) {
+		Start(TONE_DECODER_DTMF, LEVEL * LEVEL, snr);   // two tones of LEVEL^2 / 2 each
+
+		for (const char *p = pKeys; *p; p++) {
+			const unsigned k = strchr(dtmf_keys, *p) - dtmf_keys;
+			Tone(Skew(dtmf_row[k / 4], error), Skew(dtmf_col[k % 4], error), LEVEL, tone_ms);
+			Tone(0, 0, 0, gap_ms);
+		}
+		Tone(0, 0, 0, 100);
+
+		if (strcmp(got, pKeys) != 0) {
+			if (wrong++ == 0 && verbose)
+				printf("    got %s\n", got);
+		}
+	}
+
+	return wrong;
+}
+
+// 5-tone, back to back with the repeat tone for a repeated digit (44444 is 4E4E4)
+static unsigned RunSelcall(uint8_t Mode, const char *pDigits, unsigned tone_ms, double snr, double error)
+{
+	const uint16_t *tones = (Mode == TONE_DECODER_ZVEI1) ? zvei1_tones : ccir_tones;
+	unsigned        wrong = 0;
+
+	for (unsigned t = 0; t < TRIALS; t++) {
+		Start(Mode, LEVEL * LEVEL / 2, snr);
+
+		unsigned last = 10;
+		for (const char *p = pDigits; *p; p++) {
+			// the same digit twice in a row goes out as the repeat tone
+			last = (last != 10 && p[-1] == *p) ? 10 : (unsigned)(*p - '0');
+			Tone(Skew(tones[last], error), 0, LEVEL, tone_ms);
+		}
+		Tone(0, 0, 0, 200);
+
+		if (strcmp(got, pDigits) != 0) {
+			if (wrong++ == 0 && verbose)
+				printf("    got %s\n", got);
+		}
+	}
+
+	return wrong;
+}
+
+static unsigned Run1750(unsigned tone_ms, double snr, double error, const char *pExpect)
+{
+	unsigned wrong = 0;
+
+	for (unsigned t = 0; t < TRIALS; t++) {
+		Start(TONE_DECODER_DTMF | TONE_DECODER_ZVEI1 | TONE_DECODER_1750, LEVEL * LEVEL / 2, snr);
+		Tone(Skew(1750, error), 0, LEVEL, tone_ms);
+		Tone(0, 0, 0, 200);
+		if (strcmp(got, pExpect) != 0)
+			wrong++;
+	}
+
+	return wrong;
+}
+
+// symbols out of noise alone, per mode set
+static unsigned RunNoise(uint8_t Modes, unsigned seconds, double noise_sigma)
+{
+	Start(Modes, 0, 0);
+	sigma = noise_sigma;
+	Tone(0, 0, 0, seconds * 1000);
+	if (got_count > 0 && verbose)
+		printf("    got %s\n", got);
+	return got_count;
+}
+
+static unsigned failed;
+static unsigned cases;
+
+static void Check(const char *pName, unsigned wrong, unsigned out_of)
+{
+	cases++;
+	if (wrong > 0)
+		failed++;
+	if (wrong > 0 || verbose)
+		printf("%-44s %2u of %u wrong%s\n", pName, wrong, out_of, wrong ? "  <- FAIL" : "");
+}
+
+int main(int argc, char *argv[])
+{
+	char name[64];
+
+	verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+
+	// DTMF: all 16 keys at 40ms (the shortest the decoder is made for), 60 and 100ms
+	static const unsigned dtmf_ms[]  = {40, 60, 100};
+	static const int      dtmf_snr[] = {9, 6, 6};
+	for (unsigned i = 0; i < 3; i++) {
+		for (int e = -1; e <= 1; e += 2) {
+			snprintf(name, sizeof(name), "DTMF %3ums on/off, %ddB SNR, %s1%%", dtmf_ms[i], dtmf_snr[i], (e < 0) ? "-" : "+");
+			Check(name, RunDTMF(dtmf_keys, dtmf_ms[i], dtmf_ms[i], dtmf_snr[i], e), TRIALS);
+		}
+	}
+	for (unsigned i = 1; i < 3; i++) {
+		for (int e = -1; e <= 1; e += 2) {
+			snprintf(name, sizeof(name), "DTMF %3ums on/off, 9dB SNR, %s1.5%%", dtmf_ms[i], (e < 0) ? "-" : "+");
+			Check(name, RunDTMF(dtmf_keys, dtmf_ms[i], dtmf_ms[i], 9, 1.5 * e), TRIALS);
+		}
+	}
+	Check("DTMF repeated keys 40ms on/off, 9dB SNR", RunDTMF("5555##00", 40, 40, 9, 0), TRIALS);
+
+	// 5-tone: ZVEI1 70ms and CCIR 100ms a tone, a repeated digit uses the repeat tone
+	static const char * const calls[] = {"12345", "90817", "11223", "44444"};
+	for (unsigned i = 0; i < 4; i++) {
+		snprintf(name, sizeof(name), "ZVEI1 %s 70ms, 3dB SNR, 0.5%%", calls[i]);
+		Check(name, RunSelcall(TONE_DECODER_ZVEI1, calls[i], 70, 3, 0.5), TRIALS);
+		snprintf(name, sizeof(name), "CCIR  %s 100ms, 3dB SNR, 0.5%%", calls[i]);
+		Check(name, RunSelcall(TONE_DECODER_CCIR, calls[i], 100, 3, 0.5), TRIALS);
+	}
+
+	// 1750Hz: a burst long enough, one too short (needs 200ms)
+	Check("1750Hz 500ms, 3dB SNR, 1.5%", Run1750(500, 3, 1.5, "^"), TRIALS);
+	Check("1750Hz 300ms, 10dB SNR", Run1750(300, 10, 0, "^"), TRIALS);
+	Check("1750Hz 120ms, 10dB SNR (too short)", Run1750(120, 10, 0, ""), TRIALS);
+
+	// noise: 60s of it with everything switched on, quiet and loud
+	Check("noise 60s, DTMF+ZVEI1+1750, RMS 100", RunNoise(TONE_DECODER_DTMF | TONE_DECODER_ZVEI1 | TONE_DECODER_1750, 60, 100), 1);
+	Check("noise 60s, DTMF+ZVEI1+1750, RMS 600", RunNoise(TONE_DECODER_DTMF | TONE_DECODER_ZVEI1 | TONE_DECODER_1750, 60, 600), 1);
+	Check("noise 60s, DTMF+CCIR+1750, RMS 600", RunNoise(TONE_DECODER_DTMF | TONE_DECODER_CCIR | TONE_DECODER_1750, 60, 600), 1);
+
+	if (verbose) {
+		printf("\nSNR sweep, sequences decoded wrong out of %u\n\n  SNR   DTMF 40ms  DTMF 100ms  ZVEI1  CCIR\n", TRIALS);
+		for (int snr = 12; snr >= -3; snr -= 3)
+			printf("  %3d   %9u  %10u  %5u  %4u\n", snr,
+				RunDTMF(dtmf_keys, 40, 40, snr, 0), RunDTMF(dtmf_keys, 100, 100, snr, 0),
+				RunSelcall(TONE_DECODER_ZVEI1, "12345", 70, snr, 0), RunSelcall(TONE_DECODER_CCIR, "12345", 100, snr, 0));
+		printf("\n");
+	}
+
+	printf("%u of %u failed\n", failed, cases);
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,334 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// offline VOX simulator
+//
+// runs the real app/vox.c against a mic level envelope (REG_64 every 10ms),
+// side by side with a model of the BK4819's VOX as HandleVox() uses it, and
+// prints how long after the start of speech the carrier was up, how much
+// TX there was outside of speech, and how often it dropped out mid-sentence
+//
+// build and run (from the repo root):
+//
+//   make vox_sim
+//   ./vox_sim                       an hour of synthetic speech in a quiet room
+//   ./vox_sim -c 20 -k 6            noisier, 20 clicks a minute, fan noise 6x the floor
+//   ./vox_sim -f envelope.txt       a recorded envelope
+//
+// a recorded envelope has one line per 10ms: the REG_64 level and, if it's
+// known, 1 while there's speech and 0 when not (without it the keying delay
+// is timed from the first tick above the on threshold). The UART command
+// 0x0601 (BK4819 register read, ENABLE_UART_RW_BK_REGS) can log REG_64.
+//
+// synthetic envelope: a noise floor (-n) with 25% jitter, utterances of 1 to
+// 6 seconds made of 120 to 300ms syllables that rise in 30 to 50ms, 5 to 30
+// second pauses, clicks (-c a minute, 1 or 2 ticks) and now and then a
+// minute of fan noise (-k times the floor, 0 for none). Both detectors get
+// the same thresholds: the BK4819 as absolute levels, the software one as
+// margins above the floor (the same thing in a quiet room).
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/vox.h"
+
+#define TX_SETUP_10ms      3      // RADIO_SetTxParameters() until the PA's up
+#define STOP_10ms          100    // vox_stop_count_down_10ms
+#define PAUSE_10ms         10     // gVoxPauseCountdown after the BK4819's VOX interrupt
+#define BK_HOLD_10ms       64     // REG_7A VOX disable delay, 5 * 128ms
+
+static double   floorLevel  = 30;
+static double   clickRate   = 2;     // a minute
+static double   fanLevel    = 4;     // times the floor
+static uint16_t onLevel     = 90;
+static uint16_t offLevel    = 70;
+static unsigned minutes     = 60;
+static unsigned seed        = 1;
+
+static uint16_t *amp;
+static uint8_t  *speech;
+static uint32_t  ticks;
+
+static uint32_t Random(void)
+{
+	seed = seed * 1103515245u + 12345u;
+	return (seed >> 8) & 0xFFFFFF;
+}
+
+static double Uniform(void)
+{
+	return (Random() + 0.5) / 16777216.0;
+}
+
+static uint32_t Between(uint32_t lo, uint32_t hi)
+{
+	return lo + Random() % (hi - lo + 1);
+}
+
+static void MakeEnvelope(void)
+{
+	ticks  = minutes * 6000;
+	amp    = calloc(ticks, sizeof(*amp));
+	speech = calloc(ticks, sizeof(*speech));
+
+	// background, with a minute of fan noise every 10 to 20 minutes
+	uint32_t fan = Between(30000, 60000);
+	for (uint32_t t = 0; t < ticks; t++) {
+		double level = floorLevel;
+		if (fanLevel > 0 && t >= fan) {
+			level *= fanLevel;
+			if (t >= fan + 6000)
+				fan += Between(60000, 120000);
+		}
+		amp[t] = level * (0.75 + 0.5 * Uniform());
+	}
+
+	// speech
+	for (uint32_t t = Between(500, 3000); t < ticks; t += Between(500, 3000)) {
+		const uint32_t end = t + Between(100, 600);
+		while (t < end && t < ticks) {
+			const uint32_t len  = Between(12, 30);
+			const uint32_t rise = Between(3, 5);
+			const double   peak = Between(120, 500);
+			for (uint32_t i = 0; i < len && t < ticks; i++, t++) {
+				const double a = (i < rise) ? peak * (i + 1) / rise : peak * (len - i) / (len - rise);
+				if (amp[t] < a)
+					amp[t] = a;
+				speech[t] = 1;
+			}
+			// the gap between syllables, still speech as far as keying goes
+			for (uint32_t i = Between(4, 15); i > 0 && t < end && t < ticks; i--, t++)
+				speech[t] = 1;
+		}
+	}
+
+	// clicks, knocks, the odd cough
+	if (clickRate > 0) {
+		for (uint32_t t = 0; t < ticks; t += (uint32_t)(6000.0 / clickRate * 2 * Uniform())) {
+			amp[t] = Between(200, 600);
+			if (t + 1 < ticks && (Random() & 1))
+				amp[t + 1] = amp[t] / 2;
+		}
+	}
+}
+
+static bool LoadEnvelope(const char *pName)
+{
+	FILE    *f = fopen(pName, "r");
+	char     line[64];
+	uint32_t size = 0;
+	bool     labelled = true;
+
+	if (f == NULL)
+		return false;
+
+	ticks = 0;
+	while (fgets(line, sizeof(line), f)) {
+		unsigned int level;
+		unsigned int label = 0;
+		const int    n     = sscanf(line, "%u %u", &level, &label);
+		if (n < 1)
+			continue;
+		if (n < 2)
+			labelled = false;
+		if (ticks == size) {
+			size   = size ? size * 2 : 4096;
+			amp    = realloc(amp, size * sizeof(*amp));
+			speech = realloc(speech, size * sizeof(*speech));
+		}
+		amp[ticks]    = (level > 0x7FFF) ? 0x7FFF : level;
+		speech[ticks] = label != 0;
+		ticks++;
+	}
+	fclose(f);
+
+	if (!labelled) {
+		// no labels, take speech as anything over the on threshold plus a second
+		uint32_t hang = 0;
+		for (uint32_t t = 0; t < ticks; t++) {
+			if (amp[t] >= onLevel)
+				hang = 100;
+			speech[t] = hang > 0;
+			if (hang)
+				hang--;
+		}
+	}
+
+	return ticks > 0;
+}
+
+typedef struct {
+	uint32_t utterances;
+	uint32_t keyed;           // utterances that got a carrier while they lasted
+	uint64_t delaySum;
+	uint32_t worst;
+	uint32_t falseKeys;       // keyed up with nobody talking
+	uint32_t dropouts;        // let go in mid-sentence
+	uint64_t txTicks;
+	uint64_t speechTicks;
+	uint64_t idleTxTicks;     // on air with nobody talking
+} Result_t;
+
+static Result_t Run(const bool software)
+{
+	Result_t r;
+	bool     voice   = false;  // the detector's idea, g_VOX_Lost
+	uint16_t pause   = 0;
+	uint16_t bkBelow = 0;
+	bool     tx      = false;
+	uint16_t setup   = 0;
+	uint16_t stop    = 0;
+	uint32_t onset   = 0;
+	bool     waiting = false;  // an utterance without a carrier yet
+
+	memset(&r, 0, sizeof(r));
+	VOX_Start(onLevel - floorLevel, offLevel - floorLevel);
+
+	for (uint32_t t = 0; t < ticks; t++) {
+		if (speech[t] && (t == 0 || !speech[t - 1])) {
+			r.utterances++;
+			onset   = t;
+			waiting = true;
+		}
+
+		// the detector
+		if (software) {
+			switch (VOX_Sample(amp[t])) {
+				case VOX_EVENT_START: voice = true;  pause = 0; break;
+				case VOX_EVENT_STOP:  voice = false; pause = 0; break;
+				default: break;
+			}
+		}
+		else {
+			if (amp[t] > onLevel) {
+				bkBelow = 0;
+				if (!voice) {
+					voice = true;
+					pause = PAUSE_10ms;
+				}
+			}
+			else if (voice && amp[t] < offLevel && ++bkBelow >= BK_HOLD_10ms) {
+				voice = false;
+				pause = 0;
+			}
+		}
+
+		// HandleVox()
+		if (pause > 0) {
+			pause--;
+		}
+		else if (voice) {
+			stop = STOP_10ms;
+			if (!tx) {
+				tx    = true;
+				setup = TX_SETUP_10ms;
+				if (!speech[t])
+					r.falseKeys++;
+			}
+		}
+		else if (tx && stop > 0 && --stop == 0) {
+			tx = false;
+			if (speech[t])
+				r.dropouts++;
+		}
+
+		// on air
+		const bool carrier = tx && (setup == 0 || --setup == 0);
+		if (carrier) {
+			r.txTicks++;
+			if (!speech[t])
+				r.idleTxTicks++;
+		}
+		if (speech[t]) {
+			r.speechTicks++;
+			if (carrier && waiting) {
+				const uint32_t delay = t - onset;
+				r.keyed++;
+				r.delaySum += delay;
+				if (delay > r.worst)
+					r.worst = delay;
+				waiting = false;
+			}
+		}
+	}
+
+	return r;
+}
+
+static void Print(const char *pName, const Result_t *r)
+{
+	const double hours = ticks / 360000.0;
+
+	printf("  %-9s keyed %5.1f%%  delay avg %4.0fms max %5ums  false %5.1f/h  dropouts %4u  TX %5.1f%% of speech, idle %5.1f%%\n",
+		pName,
+		r->utterances ? 100.0 * r->keyed / r->utterances : 0.0,
+		r->keyed ? 10.0 * r->delaySum / r->keyed : 0.0,
+		r->worst * 10,
+		r->falseKeys / hours,
+		r->dropouts,
+		r->speechTicks ? 100.0 * (r->txTicks - r->idleTxTicks) / r->speechTicks : 0.0,
+		100.0 * r->idleTxTicks / ticks);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *pFile = NULL;
+
+	for (int i = 1; i < argc - 1; i++) {
+		if      (!strcmp(argv[i], "-f")) pFile      = argv[++i];
+		else if (!strcmp(argv[i], "-n")) floorLevel = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-c")) clickRate  = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-k")) fanLevel   = atof(argv[++i]);
+		else if (!strcmp(argv[i], "-t")) onLevel    = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-u")) offLevel   = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-m")) minutes    = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "-x")) seed       = atoi(argv[++i]);
+	}
+
+	if (minutes < 1 || floorLevel < 1 || offLevel > onLevel || onLevel <= floorLevel) {
+		fprintf(stderr, "usage: %s [-f envelope] [-n floor] [-c clicks/minute] [-k fan x floor]"
+		                " [-t on level] [-u off level] [-m minutes] [-x seed]\n", argv[0]);
+		return 1;
+	}
+
+	if (pFile != NULL) {
+		if (!LoadEnvelope(pFile)) {
+			fprintf(stderr, "can't read %s\n", pFile);
+			return 1;
+		}
+		printf("%s: %.1f minutes", pFile, ticks / 6000.0);
+	}
+	else {
+		MakeEnvelope();
+		printf("%u minutes, floor %.0f, %.1f clicks a minute, fan %.0fx", minutes, floorLevel, clickRate, fanLevel);
+	}
+
+	printf(", on %u off %u, attack %ums hold %ums, TX setup %ums\n\n",
+		onLevel, offLevel, VOX_ATTACK_10ms * 10, VOX_HOLD_10ms * 10, TX_SETUP_10ms * 10);
+
+	const Result_t bk = Run(false);
+	const Result_t sw = Run(true);
+
+	Print("BK4819", &bk);
+	Print("software", &sw);
+
+	free(amp);
+	free(speech);
+	return 0;
+}